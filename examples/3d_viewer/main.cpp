@@ -1,6 +1,7 @@
 #include "absl/strings/str_format.h"
 #include "examples/3d_viewer/utils/point_cloud.h"
 #include "gl/scene/drawables/all.h"
+#include "gl/scene/font_pool.h"
 #include "gl/viewer/viewer.h"
 
 #include <Eigen/Geometry>
@@ -21,6 +22,11 @@ using utils::Image;
 int main(int argc, char* argv[]) {
   gl::SceneViewer viewer{"3D Scene Viewer"};
   viewer.Initialize();
+  // Load the fonts in the background while the rest of the scene is created.
+  auto& font_pool = gl::FontPool::Instance();
+  const auto font_name = font_pool.PreloadFont("gl/scene/fonts/ubuntu.fnt");
+  const auto sdf_font_name =
+      font_pool.PreloadFont("gl/scene/fonts/ubuntu_sdf.fnt");
 
   auto& program_pool = viewer.program_pool();
 
@@ -48,8 +54,13 @@ int main(int argc, char* argv[]) {
   CHECK(draw_textured_rect_on_screen_program_index.has_value());
   const auto draw_text_program_index =
       program_pool.AddProgramFromShaders(Shader::CreateFromFiles(
-          {"gl/scene/shaders/text.vert", "gl/scene/shaders/texture.frag"}));
+          {"gl/scene/shaders/text.vert", "gl/scene/shaders/text_sdf.frag"}));
   CHECK(draw_text_program_index.has_value());
+  const auto draw_text_on_screen_program_index =
+      program_pool.AddProgramFromShaders(
+          Shader::CreateFromFiles({"gl/scene/shaders/text_on_screen.vert",
+                                   "gl/scene/shaders/text.frag"}));
+  CHECK(draw_text_on_screen_program_index.has_value());
 
   auto cloud_ptr =
       PointCloud::FromFile("examples/3d_viewer/utils/test_data/cloud.txt");
@@ -86,7 +97,31 @@ int main(int argc, char* argv[]) {
       texture_face,
       Eigen::Vector2f{0.5F, 0.5F});
 
+  CHECK(font_name.get().has_value());
+  const auto font = font_pool.Get(font_name.get().value());
+  // The distance field font stays sharp at any distance from the camera.
+  CHECK(sdf_font_name.get().has_value());
+  const auto sdf_font = font_pool.Get(sdf_font_name.get().value());
+  // All the labels in the world are drawn with a single draw call.
+  const auto labels_drawable =
+      std::make_shared<gl::TextBatch>(&viewer.program_pool(),
+                                      draw_text_program_index.value(),
+                                      sdf_font);
+  labels_drawable->AddLabel("Origin", Eigen::Vector3f::Zero());
+  labels_drawable->AddLabel("Face", {5.0f, 0.0f, 0.0f});
+  labels_drawable->AddLabel("Another face", {-1.0f, -1.0f, 2.0f});
+  const auto title_drawable = std::make_shared<gl::Text>(
+      &viewer.program_pool(),
+      draw_text_on_screen_program_index.value(),
+      font,
+      "3D Scene Viewer",
+      Eigen::Vector3f::Zero(),
+      0.08f);
+
   viewer.Attach(viewer.world_key(), points_drawable);
+  viewer.Attach(viewer.world_key(), labels_drawable);
+  // Hide the labels that would overlap a more important one on the screen.
+  viewer.DeclutterLabels(labels_drawable, {3.0f, 1.0f, 2.0f});
   viewer.Attach(viewer.camera_key(), camera_center_drawable);
   viewer.Attach(
       viewer.world_key(),
@@ -103,6 +138,7 @@ int main(int argc, char* argv[]) {
           Eigen::AngleAxisf(0.0, Eigen::Vector3f::UnitY()) *
           Eigen::AngleAxisf(-0.5F * M_PIf32, Eigen::Vector3f::UnitZ()));
   viewer.AttachToScreen(texture_2d_drawable, {0.5f, 0.5f});
+  viewer.AttachToScreen(title_drawable, {-0.95f, 0.85f});
 
   viewer.camera().LookAt({0.0f, 0.0f, 0.0f}, {-10.0f, 0.0f, 3.0f});
 
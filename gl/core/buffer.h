@@ -5,6 +5,8 @@
 #include "gl/core/traits.h"
 #include "utils/type_traits.h"
 
+#include "glog/logging.h"
+
 #include <map>
 #include <vector>
 
@@ -15,12 +17,16 @@ class Buffer : public OpenGlObject {
  public:
   enum class Type : GLenum {
     kArrayBuffer = GL_ARRAY_BUFFER,
-    kElementArrayBuffer = GL_ELEMENT_ARRAY_BUFFER
+    kElementArrayBuffer = GL_ELEMENT_ARRAY_BUFFER,
+    kShaderStorageBuffer = GL_SHADER_STORAGE_BUFFER,
+    kTextureBuffer = GL_TEXTURE_BUFFER,
+    kPixelUnpackBuffer = GL_PIXEL_UNPACK_BUFFER
   };
 
   enum class Usage : GLenum {
     kStaticDraw = GL_STATIC_DRAW,
-    kDynamicDraw = GL_DYNAMIC_DRAW
+    kDynamicDraw = GL_DYNAMIC_DRAW,
+    kStreamDraw = GL_STREAM_DRAW
   };
 
   Buffer(Buffer::Type type, Buffer::Usage usage)
@@ -94,6 +100,68 @@ class Buffer : public OpenGlObject {
     }
   }
 
+  /// Overwrite a part of the data store in place without reallocating it. The
+  /// offset is measured in elements of the stored type.
+  template <typename T>
+  void UpdateData(std::size_t first_element,
+                  const T* const data,
+                  std::size_t number_of_elements) {
+    CHECK_EQ(sizeof(T), data_sizeof_) << "Updating data with a wrong type.";
+    CHECK_LE(first_element + number_of_elements, number_of_elements_)
+        << "Range is out of the buffer bounds.";
+    const auto previously_bound_buffer{Bind()};
+    glBufferSubData(type_,
+                    first_element * data_sizeof_,
+                    number_of_elements * data_sizeof_,
+                    data);
+    if (previously_bound_buffer != id_) {
+      UnBindAndRebind(previously_bound_buffer);
+    }
+  }
+
+  /// Copy the data stored in the buffer back to the CPU. This waits for all
+  /// the GPU commands that write into this buffer to finish.
+  template <typename T>
+  std::vector<T> ReadData() const {
+    CHECK_EQ(sizeof(T), data_sizeof_) << "Reading data as a wrong type.";
+    std::vector<T> data(number_of_elements_);
+    const auto previously_bound_buffer{Bind()};
+    glGetBufferSubData(
+        type_, 0, data_sizeof_ * number_of_elements_, data.data());
+    if (previously_bound_buffer != id_) {
+      UnBindAndRebind(previously_bound_buffer);
+    }
+    return data;
+  }
+
+  /// Map the whole data store of this buffer for writing. The previous
+  /// contents of the buffer are discarded, which allows the driver to hand out
+  /// fresh memory instead of waiting for the GPU to finish reading the old one.
+  /// Returns nullptr if mapping failed.
+  void* MapForWriting() const {
+    const auto previously_bound_buffer{Bind()};
+    void* const mapped_data{
+        glMapBufferRange(type_,
+                         0,
+                         data_sizeof_ * number_of_elements_,
+                         GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT)};
+    if (previously_bound_buffer != id_) {
+      UnBindAndRebind(previously_bound_buffer);
+    }
+    return mapped_data;
+  }
+
+  /// Release the mapping created by MapForWriting. Returns false if the data
+  /// store got corrupted while mapped and must be written again.
+  bool Unmap() const {
+    const auto previously_bound_buffer{Bind()};
+    const bool success{glUnmapBuffer(type_) == GL_TRUE};
+    if (previously_bound_buffer != id_) {
+      UnBindAndRebind(previously_bound_buffer);
+    }
+    return success;
+  }
+
   inline GLuint Bind() const {
     GLuint bound_buffer{GetCurrentlyBoundBuffer(type_)};
     if (bound_buffer != id_) { glBindBuffer(type_, id_); }
@@ -106,6 +174,30 @@ class Buffer : public OpenGlObject {
     glBindBuffer(type_, id_to_bind);
   }
 
+  /// Bind the whole buffer to an indexed binding point, e.g., the one used by
+  /// a shader storage block in a shader.
+  inline void BindBase(GLuint binding_index) const {
+    CHECK(IsIndexedType(type_))
+        << "Only shader storage buffers can be bound to an index.";
+    glBindBufferBase(type_, binding_index, id_);
+  }
+
+  /// Bind a part of the buffer to an indexed binding point. The offset and
+  /// size are measured in elements of the stored type.
+  inline void BindRange(GLuint binding_index,
+                        std::size_t first_element,
+                        std::size_t number_of_elements) const {
+    CHECK(IsIndexedType(type_))
+        << "Only shader storage buffers can be bound to an index.";
+    CHECK_LE(first_element + number_of_elements, number_of_elements_)
+        << "Range is out of the buffer bounds.";
+    glBindBufferRange(type_,
+                      binding_index,
+                      id_,
+                      first_element * data_sizeof_,
+                      number_of_elements * data_sizeof_);
+  }
+
   inline Buffer::Type type() const { return static_cast<Buffer::Type>(type_); }
   inline Buffer::Usage usage() const {
     return static_cast<Buffer::Usage>(usage_);
@@ -129,10 +221,17 @@ class Buffer : public OpenGlObject {
     switch (type) {
       case GL_ARRAY_BUFFER: return GL_ARRAY_BUFFER_BINDING;
       case GL_ELEMENT_ARRAY_BUFFER: return GL_ELEMENT_ARRAY_BUFFER_BINDING;
+      case GL_SHADER_STORAGE_BUFFER: return GL_SHADER_STORAGE_BUFFER_BINDING;
+      case GL_TEXTURE_BUFFER: return GL_TEXTURE_BUFFER_BINDING;
+      case GL_PIXEL_UNPACK_BUFFER: return GL_PIXEL_UNPACK_BUFFER_BINDING;
     }
     return 0;
   }
 
+  static inline bool IsIndexedType(GLenum type) {
+    return type == GL_SHADER_STORAGE_BUFFER;
+  }
+
   GLenum type_{};
   GLenum usage_{};
 
@@ -1,4 +1,5 @@
 #include "gl/core/buffer.h"
+#include "gl/core/texture.h"
 #include "gl/utils/eigen_traits.h"
 #include "utils/eigen_utils.h"
 #include "gtest/gtest.h"
@@ -103,3 +104,68 @@ TEST(BufferTest, BindUnbind) {
   }
   ASSERT_EQ(0, GetCurrentlyBoundBuffer(GL_ARRAY_BUFFER_BINDING));
 }
+
+TEST(BufferTest, ShaderStorageBindBase) {
+  std::vector<std::uint32_t> labels{1, 2, 3, 4};
+  Buffer buffer{
+      Buffer::Type::kShaderStorageBuffer, Buffer::Usage::kDynamicDraw, labels};
+  EXPECT_EQ(GL_SHADER_STORAGE_BUFFER, buffer.gl_type());
+  EXPECT_EQ(GL_UNSIGNED_INT, buffer.gl_underlying_data_type());
+  buffer.BindBase(2u);
+  GLint bound_buffer{};
+  glGetIntegeri_v(GL_SHADER_STORAGE_BUFFER_BINDING, 2u, &bound_buffer);
+  EXPECT_EQ(buffer.id(), static_cast<GLuint>(bound_buffer));
+}
+
+TEST(BufferTest, ShaderStorageBindRange) {
+  GLint alignment{};
+  glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+  ASSERT_GT(alignment, 0);
+  const std::size_t first_element{alignment / sizeof(float)};
+  const std::size_t number_of_elements{4ul};
+  std::vector<float> data(first_element + number_of_elements, 1.0f);
+  Buffer buffer{
+      Buffer::Type::kShaderStorageBuffer, Buffer::Usage::kDynamicDraw, data};
+  buffer.BindRange(1u, first_element, number_of_elements);
+  GLint64 start{};
+  GLint64 size{};
+  glGetInteger64i_v(GL_SHADER_STORAGE_BUFFER_START, 1u, &start);
+  glGetInteger64i_v(GL_SHADER_STORAGE_BUFFER_SIZE, 1u, &size);
+  EXPECT_EQ(static_cast<GLint64>(first_element * sizeof(float)), start);
+  EXPECT_EQ(static_cast<GLint64>(number_of_elements * sizeof(float)), size);
+}
+
+TEST(BufferDeathTest, BindBaseOfNonIndexedBuffer) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  Buffer buffer{Buffer::Type::kArrayBuffer, Buffer::Usage::kStaticDraw};
+  EXPECT_DEATH(buffer.BindBase(0u), ".*can be bound to an index.*");
+}
+
+TEST(BufferTest, TextureBuffer) {
+  std::vector<std::uint32_t> labels{1, 2, 3, 4};
+  Buffer buffer{
+      Buffer::Type::kTextureBuffer, Buffer::Usage::kStaticDraw, labels};
+  auto texture{Texture::Builder{Texture::Type::kTextureBuffer,
+                                Texture::Identifier::kTexture0}
+                   .WithBuffer(buffer)
+                   .Build()};
+  texture->Bind();
+  GLint data_store{};
+  GLint internal_format{};
+  glGetTexLevelParameteriv(
+      GL_TEXTURE_BUFFER, 0, GL_TEXTURE_BUFFER_DATA_STORE_BINDING, &data_store);
+  glGetTexLevelParameteriv(
+      GL_TEXTURE_BUFFER, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format);
+  texture->UnBind();
+  EXPECT_EQ(buffer.id(), static_cast<GLuint>(data_store));
+  EXPECT_EQ(GL_R32UI, internal_format);
+}
+
+TEST(BufferTest, UpdateData) {
+  std::vector<float> data{1, 2, 3, 4};
+  Buffer buffer{Buffer::Type::kArrayBuffer, Buffer::Usage::kDynamicDraw, data};
+  const std::vector<float> update{5, 6};
+  buffer.UpdateData(1ul, update.data(), update.size());
+  EXPECT_EQ(4, buffer.number_of_elements());
+  EXPECT_EQ((std::vector<float>{1, 5, 6, 4}), buffer.ReadData<float>());
+}
@@ -8,7 +8,7 @@ using gl::glfw::Viewer;
 int main(int argc, char** argv) {
   google::InitGoogleLogging(*argv);
   Viewer viewer{"TestViewer"};
-  bool initialized = viewer.InitializeHidden();
+  bool initialized = viewer.InitializeHidden({800, 600}, {4, 3});
   if (!initialized) { return 1; }
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
@@ -0,0 +1,36 @@
+#ifndef OPENGL_TUTORIALS_CORE_MEMORY_BARRIER_H_
+#define OPENGL_TUTORIALS_CORE_MEMORY_BARRIER_H_
+
+#include "gl/core/opengl_object.h"
+
+namespace gl {
+
+/// Types of memory accesses that must see the results of previous incoherent
+/// writes, e.g., those from a compute shader into a shader storage buffer.
+enum class BarrierBit : GLbitfield {
+  kVertexAttribArray = GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT,
+  kElementArray = GL_ELEMENT_ARRAY_BARRIER_BIT,
+  kUniform = GL_UNIFORM_BARRIER_BIT,
+  kTextureFetch = GL_TEXTURE_FETCH_BARRIER_BIT,
+  kShaderImageAccess = GL_SHADER_IMAGE_ACCESS_BARRIER_BIT,
+  kCommand = GL_COMMAND_BARRIER_BIT,
+  kPixelBuffer = GL_PIXEL_BUFFER_BARRIER_BIT,
+  kTextureUpdate = GL_TEXTURE_UPDATE_BARRIER_BIT,
+  kBufferUpdate = GL_BUFFER_UPDATE_BARRIER_BIT,
+  kFramebuffer = GL_FRAMEBUFFER_BARRIER_BIT,
+  kAtomicCounter = GL_ATOMIC_COUNTER_BARRIER_BIT,
+  kShaderStorage = GL_SHADER_STORAGE_BARRIER_BIT,
+  kAll = GL_ALL_BARRIER_BITS,
+};
+
+/// Order the memory transactions issued before this call with the ones of
+/// the given types issued after it.
+template <typename... Ts>
+inline void MemoryBarrier(BarrierBit barrier, Ts... barriers) {
+  glMemoryBarrier((static_cast<GLbitfield>(barrier) | ... |
+                   static_cast<GLbitfield>(barriers)));
+}
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_CORE_MEMORY_BARRIER_H_
@@ -2,6 +2,8 @@
 
 #include "absl/strings/str_format.h"
 
+#include <algorithm>
+
 namespace gl {
 
 bool Program::Link() const {
@@ -9,6 +11,38 @@ bool Program::Link() const {
   return true;
 }
 
+void Program::Dispatch(GLuint number_of_groups_x,
+                       GLuint number_of_groups_y,
+                       GLuint number_of_groups_z) const {
+  const auto has_compute_shader{std::any_of(
+      attached_shaders_.cbegin(),
+      attached_shaders_.cend(),
+      [](const auto& shader) {
+        return shader && shader->type() == Shader::Type::kComputeShader;
+      })};
+  CHECK(has_compute_shader)
+      << "Cannot dispatch a program without a compute shader.";
+  Use();
+  glDispatchCompute(number_of_groups_x, number_of_groups_y, number_of_groups_z);
+}
+
+void Program::CommitPendingUniforms() {
+  for (const auto uniform_index : pending_uniforms_) {
+    uniforms_[uniform_index].Commit();
+    queued_uniforms_[uniform_index] = false;
+  }
+  pending_uniforms_.clear();
+}
+
+bool Program::BindShaderStorageBlock(const std::string& block_name,
+                                     GLuint binding_index) const {
+  const auto block_index{glGetProgramResourceIndex(
+      id_, GL_SHADER_STORAGE_BLOCK, block_name.c_str())};
+  if (block_index == GL_INVALID_INDEX) { return false; }
+  glShaderStorageBlockBinding(id_, block_index, binding_index);
+  return true;
+}
+
 Uniform* Program::EmplaceUniform(Uniform&& uniform) {
   if (uniform_ids_.count(uniform.name()) > 0) {
     const size_t found_index = uniform_ids_.at(uniform.name());
@@ -17,6 +51,7 @@ Uniform* Program::EmplaceUniform(Uniform&& uniform) {
   }
   const size_t index = uniforms_.size();
   uniform_ids_.emplace(uniform.name(), index);
+  queued_uniforms_.push_back(false);
   return &uniforms_.emplace_back(std::forward<Uniform>(uniform));
 }
 
@@ -32,6 +67,7 @@ size_t Program::GetUniformIndexOrEmplace(const std::string& uniform_name) {
   if (uniform_ids_.count(uniform_name) < 1) {
     uniform_ids_.emplace(uniform_name, uniforms_.size());
     uniforms_.emplace_back(uniform_name, id_);
+    queued_uniforms_.push_back(false);
     return uniforms_.size() - 1U;
   }
   return uniform_ids_.at(uniform_name);
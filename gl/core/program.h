@@ -26,6 +26,12 @@ class Program : public OpenGlObject {
 
   inline void Use() const { glUseProgram(id_); }
 
+  /// Launch a grid of compute work groups. Only valid for programs that have
+  /// a compute shader attached. This makes this program the active one.
+  void Dispatch(GLuint number_of_groups_x,
+                GLuint number_of_groups_y = 1u,
+                GLuint number_of_groups_z = 1u) const;
+
   template <typename T, typename A>
   [[nodiscard]] inline std::size_t SetUniform(const std::string& uniform_name,
                                               const std::vector<T, A>& data) {
@@ -42,6 +48,38 @@ class Program : public OpenGlObject {
     return uniform_index;
   }
 
+  /// Remember a uniform value to be sent with the next call to
+  /// CommitPendingUniforms. Returns the index of the uniform.
+  template <typename... Ts>
+  [[nodiscard]] inline std::size_t StageUniform(const std::string& uniform_name,
+                                                const Ts&... values) {
+    const auto uniform_index{GetUniformIndexOrEmplace(uniform_name)};
+    StageUniformUpdate(uniform_index, values...);
+    return uniform_index;
+  }
+
+  /// Use this version when the uniform index is already known.
+  template <typename... Ts>
+  inline void StageUniformUpdate(std::size_t uniform_index,
+                                 const Ts&... values) {
+    auto& uniform{GetUniform(uniform_index)};
+    uniform.StageValue(values...);
+    // A uniform can stop and start waiting for a commit many times before the
+    // next commit, so only queue it once.
+    if (uniform.has_pending_value() && !queued_uniforms_[uniform_index]) {
+      queued_uniforms_[uniform_index] = true;
+      pending_uniforms_.push_back(uniform_index);
+    }
+  }
+
+  /// Send all staged uniform values that changed since the last commit.
+  void CommitPendingUniforms();
+
+  /// Number of uniforms that wait for the next commit.
+  inline std::size_t number_of_pending_uniforms() const noexcept {
+    return pending_uniforms_.size();
+  }
+
   [[nodiscard]] Uniform& GetUniform(std::size_t index) noexcept {
     CHECK_LT(index, uniforms_.size());
     return uniforms_[index];
@@ -54,6 +92,11 @@ class Program : public OpenGlObject {
 
   [[nodiscard]] bool Link() const;
 
+  /// Connect a shader storage block with this name to an indexed binding
+  /// point. Returns false if there is no such block in the program.
+  bool BindShaderStorageBlock(const std::string& block_name,
+                              GLuint binding_index) const;
+
   [[nodiscard]] Uniform* EmplaceUniform(Uniform&& uniform);
 
   [[nodiscard]] static std::optional<Program> CreateFromShaders(
@@ -67,6 +110,8 @@ class Program : public OpenGlObject {
     id_ = other.id_;
     uniforms_ = std::move(other.uniforms_);
     uniform_ids_ = std::move(other.uniform_ids_);
+    pending_uniforms_ = std::move(other.pending_uniforms_);
+    queued_uniforms_ = std::move(other.queued_uniforms_);
     attached_shaders_ = std::move(other.attached_shaders_);
     other.id_ = 0;
     return *this;
@@ -80,6 +125,9 @@ class Program : public OpenGlObject {
 
   std::vector<Uniform> uniforms_{};
   std::map<std::string, std::size_t> uniform_ids_{};
+  std::vector<std::size_t> pending_uniforms_{};
+  /// Whether a uniform at this index is in pending_uniforms_.
+  std::vector<bool> queued_uniforms_{};
   std::vector<std::shared_ptr<Shader>> attached_shaders_{};
 };
 
@@ -1,3 +1,5 @@
+#include "gl/core/buffer.h"
+#include "gl/core/memory_barrier.h"
 #include "gl/core/program.h"
 #include "gtest/gtest.h"
 
@@ -13,3 +15,89 @@ TEST(ProgramTest, Init) {
   auto program{Program::CreateFromShaders({vertex_shader, fragment_shader})};
   ASSERT_TRUE(program.has_value());
 }
+
+TEST(ProgramTest, QueueStagedUniformOnce) {
+  const std::shared_ptr<Shader> vertex_shader{
+      Shader::CreateFromFile("gl/core/test_shaders/shader.vert")};
+  ASSERT_NE(vertex_shader, nullptr);
+  const std::shared_ptr<Shader> fragment_shader{
+      Shader::CreateFromFile("gl/core/test_shaders/shader.frag")};
+  ASSERT_NE(fragment_shader, nullptr);
+  auto program{Program::CreateFromShaders({vertex_shader, fragment_shader})};
+  ASSERT_TRUE(program.has_value());
+  program->Use();
+  const auto index{program->StageUniform("dummy_value_dim_1", 1.0F)};
+  program->CommitPendingUniforms();
+  EXPECT_EQ(program->number_of_pending_uniforms(), 0u);
+  for (int i = 0; i < 10; ++i) {
+    program->StageUniformUpdate(index, 2.0F);
+    program->StageUniformUpdate(index, 1.0F);
+  }
+  program->StageUniformUpdate(index, 2.0F);
+  EXPECT_EQ(program->number_of_pending_uniforms(), 1u);
+  program->CommitPendingUniforms();
+  EXPECT_EQ(program->number_of_pending_uniforms(), 0u);
+  GLfloat value{};
+  glGetUniformfv(program->id(),
+                 glGetUniformLocation(program->id(), "dummy_value_dim_1"),
+                 &value);
+  EXPECT_FLOAT_EQ(value, 2.0F);
+}
+
+TEST(ProgramTest, BindShaderStorageBlock) {
+  const std::shared_ptr<Shader> vertex_shader{
+      Shader::CreateFromFile("gl/core/test_shaders/storage.vert")};
+  ASSERT_NE(vertex_shader, nullptr);
+  const std::shared_ptr<Shader> fragment_shader{
+      Shader::CreateFromFile("gl/core/test_shaders/shader.frag")};
+  ASSERT_NE(fragment_shader, nullptr);
+  auto program{Program::CreateFromShaders({vertex_shader, fragment_shader})};
+  ASSERT_TRUE(program.has_value());
+  EXPECT_FALSE(program->BindShaderStorageBlock("NonExistingBlock", 3u));
+  ASSERT_TRUE(program->BindShaderStorageBlock("PointLabels", 3u));
+  const auto block_index{glGetProgramResourceIndex(
+      program->id(), GL_SHADER_STORAGE_BLOCK, "PointLabels")};
+  const GLenum property{GL_BUFFER_BINDING};
+  GLint binding{};
+  glGetProgramResourceiv(program->id(),
+                         GL_SHADER_STORAGE_BLOCK,
+                         block_index,
+                         1,
+                         &property,
+                         1,
+                         nullptr,
+                         &binding);
+  EXPECT_EQ(3, binding);
+}
+
+TEST(ProgramTest, DispatchCompute) {
+  const std::shared_ptr<Shader> compute_shader{
+      Shader::CreateFromFile("gl/core/test_shaders/double_values.comp")};
+  ASSERT_NE(compute_shader, nullptr);
+  auto program{Program::CreateFromShaders({compute_shader})};
+  ASSERT_TRUE(program.has_value());
+  const std::size_t kNumberOfValues{100ul};
+  const GLuint kGroupSize{64u};
+  std::vector<float> values(kNumberOfValues);
+  for (std::size_t i = 0; i < values.size(); ++i) { values[i] = i; }
+  Buffer buffer{
+      Buffer::Type::kShaderStorageBuffer, Buffer::Usage::kDynamicDraw, values};
+  buffer.BindBase(0u);
+  program->Dispatch((kNumberOfValues + kGroupSize - 1u) / kGroupSize);
+  MemoryBarrier(BarrierBit::kBufferUpdate, BarrierBit::kShaderStorage);
+  const auto result{buffer.ReadData<float>()};
+  ASSERT_EQ(values.size(), result.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_FLOAT_EQ(2.0f * values[i], result[i]);
+  }
+}
+
+TEST(ProgramDeathTest, DispatchWithoutComputeShader) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  const std::shared_ptr<Shader> vertex_shader{
+      Shader::CreateFromFile("gl/core/test_shaders/shader.vert")};
+  ASSERT_NE(vertex_shader, nullptr);
+  auto program{Program::CreateFromShaders({vertex_shader})};
+  ASSERT_TRUE(program.has_value());
+  EXPECT_DEATH(program->Dispatch(1u), ".*without a compute shader.*");
+}
@@ -0,0 +1,44 @@
+#include "gl/core/sampler.h"
+
+#include <tuple>
+
+namespace gl {
+
+bool Sampler::Parameters::operator<(const Parameters& other) const {
+  const auto as_tuple = [](const Parameters& parameters) {
+    return std::tie(parameters.min_filter,
+                    parameters.mag_filter,
+                    parameters.wrap_s,
+                    parameters.wrap_t,
+                    parameters.wrap_r,
+                    parameters.border_color);
+  };
+  return as_tuple(*this) < as_tuple(other);
+}
+
+Sampler::Sampler(const Parameters& parameters) : parameters_{parameters} {
+  glGenSamplers(1, &id_);
+  glSamplerParameteri(id_,
+                      GL_TEXTURE_MIN_FILTER,
+                      static_cast<GLint>(parameters.min_filter));
+  glSamplerParameteri(id_,
+                      GL_TEXTURE_MAG_FILTER,
+                      static_cast<GLint>(parameters.mag_filter));
+  glSamplerParameteri(
+      id_, GL_TEXTURE_WRAP_S, static_cast<GLint>(parameters.wrap_s));
+  glSamplerParameteri(
+      id_, GL_TEXTURE_WRAP_T, static_cast<GLint>(parameters.wrap_t));
+  glSamplerParameteri(
+      id_, GL_TEXTURE_WRAP_R, static_cast<GLint>(parameters.wrap_r));
+  glSamplerParameterfv(
+      id_, GL_TEXTURE_BORDER_COLOR, parameters.border_color.data());
+}
+
+std::shared_ptr<Sampler> SamplerCache::Get(
+    const Sampler::Parameters& parameters) {
+  auto& sampler{samplers_[parameters]};
+  if (!sampler) { sampler = std::make_shared<Sampler>(parameters); }
+  return sampler;
+}
+
+}  // namespace gl
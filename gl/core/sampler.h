@@ -0,0 +1,64 @@
+#ifndef OPENGL_TUTORIALS_CORE_SAMPLER_H_
+#define OPENGL_TUTORIALS_CORE_SAMPLER_H_
+
+#include "gl/core/opengl_object.h"
+#include "gl/core/texture.h"
+
+#include <array>
+#include <map>
+#include <memory>
+
+namespace gl {
+
+/// An OpenGL sampler object that holds the wrapping and filtering state.
+///
+/// A sampler bound to a texture unit overrides the parameters stored in the
+/// texture bound to that unit, so many textures can share one sampler.
+class Sampler : public OpenGlObject {
+ public:
+  struct Parameters {
+    Texture::FilteringMode min_filter{Texture::FilteringMode::kLinear};
+    Texture::FilteringMode mag_filter{Texture::FilteringMode::kLinear};
+    Texture::WrappingMode wrap_s{Texture::WrappingMode::kRepeat};
+    Texture::WrappingMode wrap_t{Texture::WrappingMode::kRepeat};
+    Texture::WrappingMode wrap_r{Texture::WrappingMode::kRepeat};
+    /// Only used with the kClampToBorder wrapping mode.
+    std::array<float, 4> border_color{};
+
+    bool operator<(const Parameters& other) const;
+  };
+
+  explicit Sampler(const Parameters& parameters);
+  Sampler(const Sampler&) = delete;
+  Sampler& operator=(const Sampler&) = delete;
+
+  ~Sampler() {
+    if (id_) { glDeleteSamplers(1, &id_); }
+  }
+
+  inline void Bind(GLuint unit) const { glBindSampler(unit, id_); }
+  inline static void UnBind(GLuint unit) { glBindSampler(unit, 0); }
+
+  inline const Parameters& parameters() const noexcept { return parameters_; }
+
+ private:
+  Parameters parameters_{};
+};
+
+/// Shares a single sampler object between all users of the same parameters.
+class SamplerCache {
+ public:
+  /// Get a sampler with these parameters. A new sampler object is only
+  /// created if there is none with these parameters yet.
+  std::shared_ptr<Sampler> Get(const Sampler::Parameters& parameters = {});
+
+  /// Number of distinct samplers in the cache.
+  std::size_t size() const noexcept { return samplers_.size(); }
+
+ private:
+  std::map<Sampler::Parameters, std::shared_ptr<Sampler>> samplers_{};
+};
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_CORE_SAMPLER_H_
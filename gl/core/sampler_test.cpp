@@ -0,0 +1,32 @@
+#include "gl/core/sampler.h"
+#include "gtest/gtest.h"
+
+using gl::Sampler;
+using gl::SamplerCache;
+using gl::Texture;
+
+TEST(SamplerTest, Parameters) {
+  Sampler::Parameters parameters{};
+  parameters.min_filter = Texture::FilteringMode::kNearest;
+  parameters.wrap_s = Texture::WrappingMode::kClampToEdge;
+  const Sampler sampler{parameters};
+  ASSERT_NE(0u, sampler.id());
+  GLint value{};
+  glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_MIN_FILTER, &value);
+  EXPECT_EQ(GL_NEAREST, value);
+  glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_MAG_FILTER, &value);
+  EXPECT_EQ(GL_LINEAR, value);
+  glGetSamplerParameteriv(sampler.id(), GL_TEXTURE_WRAP_S, &value);
+  EXPECT_EQ(GL_CLAMP_TO_EDGE, value);
+}
+
+TEST(SamplerTest, CacheDeduplicatesParameters) {
+  SamplerCache cache{};
+  Sampler::Parameters nearest{};
+  nearest.mag_filter = Texture::FilteringMode::kNearest;
+  const auto sampler{cache.Get()};
+  EXPECT_EQ(sampler, cache.Get(Sampler::Parameters{}));
+  EXPECT_NE(sampler, cache.Get(nearest));
+  EXPECT_EQ(cache.Get(nearest), cache.Get(nearest));
+  EXPECT_EQ(2ul, cache.size());
+}
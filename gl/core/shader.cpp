@@ -53,6 +53,7 @@ Shader::Type Shader::DetectShaderType(const std::string& file_name) {
   if (extention == "vert") { return Shader::Type::kVertexShader; }
   if (extention == "frag") { return Shader::Type::kFragmentShader; }
   if (extention == "geom") { return Shader::Type::kGeometryShader; }
+  if (extention == "comp") { return Shader::Type::kComputeShader; }
   LOG(ERROR) << "Unknown shader file extention: '" << extention
              << "' for file '" << file_name;
   return Shader::Type::kUndefined;
@@ -19,7 +19,8 @@ class Shader : public OpenGlObject {
     kUndefined = -1,
     kVertexShader = GL_VERTEX_SHADER,
     kFragmentShader = GL_FRAGMENT_SHADER,
-    kGeometryShader = GL_GEOMETRY_SHADER
+    kGeometryShader = GL_GEOMETRY_SHADER,
+    kComputeShader = GL_COMPUTE_SHADER
   };
 
   Shader(const Shader&) = delete;
@@ -14,6 +14,14 @@ TEST(ShaderTest, Init) {
   EXPECT_TRUE(success);
 }
 
+TEST(ShaderTest, InitCompute) {
+  auto shader{
+      Shader::CreateFromFile("gl/core/test_shaders/double_values.comp")};
+  ASSERT_NE(shader, nullptr);
+  EXPECT_EQ(Shader::Type::kComputeShader, shader->type())
+      << static_cast<GLint>(shader->type());
+}
+
 TEST(ShaderDeathTest, InitWrongPath) {
   ::testing::FLAGS_gtest_death_test_style = "threadsafe";
   EXPECT_DEATH(Shader::CreateFromFile("wrong/path.vert"), ".*does not exist.");
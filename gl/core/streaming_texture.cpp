@@ -0,0 +1,89 @@
+#include "gl/core/streaming_texture.h"
+
+#include "glog/logging.h"
+
+#include <cstring>
+
+namespace gl {
+
+StreamingTexture::StreamingTexture(Texture::Identifier identifier,
+                                   int width,
+                                   int height,
+                                   int number_of_channels,
+                                   std::size_t number_of_buffers,
+                                   bool generate_mipmaps)
+    : width_{width},
+      height_{height},
+      number_of_channels_{number_of_channels},
+      generate_mipmaps_{generate_mipmaps} {
+  CHECK_GT(width_, 0) << "Streaming texture must not be empty.";
+  CHECK_GT(height_, 0) << "Streaming texture must not be empty.";
+  CHECK_GT(number_of_buffers, 0ul) << "Need at least one pixel buffer.";
+  Texture::InternalFormat internal_format{};
+  switch (number_of_channels_) {
+    case 3: internal_format = Texture::InternalFormat::kRGB8; break;
+    case 4: internal_format = Texture::InternalFormat::kRGBA8; break;
+    default:
+      LOG(FATAL) << "Unsupported number of channels: " << number_of_channels_;
+  }
+
+  pixel_buffers_.reserve(number_of_buffers);
+  for (std::size_t i = 0; i < number_of_buffers; ++i) {
+    auto& buffer{pixel_buffers_.emplace_back(Buffer::Type::kPixelUnpackBuffer,
+                                             Buffer::Usage::kStreamDraw)};
+    buffer.AssignData(static_cast<const std::uint8_t*>(nullptr),
+                      image_size_in_bytes());
+  }
+
+  const int number_of_levels{
+      generate_mipmaps_ ? Texture::ComputeNumberOfMipmapLevels(width_, height_)
+                        : 1};
+  texture_ =
+      Texture::Builder{Texture::Type::kTexture2D, identifier}
+          .WithSaneDefaults()
+          .WithStorage(width_, height_, number_of_levels, internal_format)
+          .Build();
+}
+
+void StreamingTexture::Update(const utils::Image& image) {
+  CHECK_EQ(image.width(), width_) << "Image size does not match the texture.";
+  CHECK_EQ(image.height(), height_) << "Image size does not match the texture.";
+  CHECK_EQ(image.number_of_channels(), number_of_channels_)
+      << "Number of image channels does not match the texture.";
+  CHECK(image.data_type() == utils::Image::DataType::kUint8)
+      << "Only 8-bit images can be streamed.";
+  Update(image.data());
+}
+
+void StreamingTexture::Update(const std::uint8_t* const data) {
+  if (data == nullptr) {
+    LOG(WARNING) << "No data to stream into the texture.";
+    return;
+  }
+  const auto& buffer{pixel_buffers_[next_buffer_index_]};
+  next_buffer_index_ = (next_buffer_index_ + 1ul) % pixel_buffers_.size();
+
+  auto* const mapped_data{buffer.MapForWriting()};
+  if (mapped_data == nullptr) {
+    LOG(WARNING) << "Could not map a pixel buffer. Skipping the update.";
+    return;
+  }
+  std::memcpy(mapped_data, data, image_size_in_bytes());
+  if (!buffer.Unmap()) {
+    LOG(WARNING) << "Pixel buffer got corrupted. Skipping the update.";
+    return;
+  }
+
+  // While a pixel unpack buffer is bound, the data pointer passed to
+  // glTexSubImage2D is an offset into that buffer and the call returns
+  // without waiting for the transfer to finish.
+  const auto previously_bound_buffer{buffer.Bind()};
+  texture_->Bind();
+  texture_->UpdateRegion(
+      0, 0, width_, height_, static_cast<const std::uint8_t*>(nullptr));
+  if (generate_mipmaps_) { texture_->GenerateMipmaps(); }
+  texture_->UnBind();
+  buffer.UnBindAndRebind(previously_bound_buffer);
+}
+
+}  // namespace gl
@@ -0,0 +1,69 @@
+#ifndef OPENGL_TUTORIALS_CORE_STREAMING_TEXTURE_H_
+#define OPENGL_TUTORIALS_CORE_STREAMING_TEXTURE_H_
+
+#include "gl/core/buffer.h"
+#include "gl/core/texture.h"
+#include "utils/image.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gl {
+
+/// A texture that is meant to be updated every frame, e.g., from a camera.
+///
+/// Every update is written into one of a ring of pixel unpack buffers and the
+/// texture is filled from that buffer. This way the copy from the buffer to
+/// the texture happens asynchronously on the GPU side and the render thread
+/// does not wait for it. Having more than one buffer in the ring makes sure
+/// we never write into a buffer that is still being read by the previous
+/// transfer.
+class StreamingTexture {
+ public:
+  StreamingTexture(Texture::Identifier identifier,
+                   int width,
+                   int height,
+                   int number_of_channels,
+                   std::size_t number_of_buffers = 2ul,
+                   bool generate_mipmaps = false);
+
+  /// Upload a new image. It must have the size and the number of channels
+  /// this texture was created with.
+  void Update(const utils::Image& image);
+
+  /// Upload tightly packed pixels with the size and number of channels this
+  /// texture was created with.
+  void Update(const std::uint8_t* const data);
+
+  inline const std::shared_ptr<Texture>& texture() const noexcept {
+    return texture_;
+  }
+
+  inline int width() const noexcept { return width_; }
+  inline int height() const noexcept { return height_; }
+  inline int number_of_channels() const noexcept {
+    return number_of_channels_;
+  }
+  inline std::size_t number_of_buffers() const noexcept {
+    return pixel_buffers_.size();
+  }
+
+ private:
+  inline std::size_t image_size_in_bytes() const noexcept {
+    return static_cast<std::size_t>(width_) * height_ * number_of_channels_;
+  }
+
+  std::shared_ptr<Texture> texture_{};
+  std::vector<Buffer> pixel_buffers_{};
+  std::size_t next_buffer_index_{};
+
+  int width_{};
+  int height_{};
+  int number_of_channels_{};
+  bool generate_mipmaps_{};
+};
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_CORE_STREAMING_TEXTURE_H_
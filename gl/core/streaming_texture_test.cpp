@@ -0,0 +1,77 @@
+#include "gl/core/streaming_texture.h"
+#include "gtest/gtest.h"
+
+#include <numeric>
+#include <vector>
+
+using namespace gl;
+
+namespace {
+std::vector<std::uint8_t> ReadTexture(Texture* texture,
+                                      int width,
+                                      int height,
+                                      int number_of_channels,
+                                      GLenum color_mode) {
+  std::vector<std::uint8_t> pixels(width * height * number_of_channels);
+  texture->Bind();
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(
+      GL_TEXTURE_2D, 0, color_mode, GL_UNSIGNED_BYTE, pixels.data());
+  texture->UnBind();
+  return pixels;
+}
+}  // namespace
+
+TEST(StreamingTextureTest, Init) {
+  StreamingTexture texture{Texture::Identifier::kTexture0, 4, 2, 4, 3ul};
+  ASSERT_NE(texture.texture(), nullptr);
+  EXPECT_NE(texture.texture()->id(), 0u);
+  EXPECT_EQ(texture.width(), 4);
+  EXPECT_EQ(texture.height(), 2);
+  EXPECT_EQ(texture.number_of_channels(), 4);
+  EXPECT_EQ(texture.number_of_buffers(), 3ul);
+}
+
+TEST(StreamingTextureTest, UpdateThroughAllBuffers) {
+  // Rows of 3 RGB pixels are not 4-byte aligned.
+  const int width{3};
+  const int height{2};
+  const int channels{3};
+  StreamingTexture texture{
+      Texture::Identifier::kTexture0, width, height, channels, 2ul, true};
+  std::vector<std::uint8_t> frame(width * height * channels);
+  for (std::uint8_t frame_index = 0; frame_index < 5; ++frame_index) {
+    std::iota(frame.begin(), frame.end(), frame_index);
+    texture.Update(frame.data());
+    EXPECT_EQ(frame,
+              ReadTexture(
+                  texture.texture().get(), width, height, channels, GL_RGB));
+  }
+  GLint bound_buffer{};
+  glGetIntegerv(GL_PIXEL_UNPACK_BUFFER_BINDING, &bound_buffer);
+  EXPECT_EQ(bound_buffer, 0);
+  GLint alignment{};
+  glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+  EXPECT_EQ(alignment, 4);
+}
+
+TEST(StreamingTextureTest, UpdateFromImage) {
+  const auto image{
+      utils::Image::CreateFrom("utils/test_images/container.jpg")};
+  ASSERT_TRUE(image.has_value());
+  StreamingTexture texture{Texture::Identifier::kTexture0,
+                           image->width(),
+                           image->height(),
+                           image->number_of_channels()};
+  texture.Update(image.value());
+  const std::vector<std::uint8_t> expected(
+      image->data(),
+      image->data() +
+          image->width() * image->height() * image->number_of_channels());
+  EXPECT_EQ(expected,
+            ReadTexture(texture.texture().get(),
+                        image->width(),
+                        image->height(),
+                        image->number_of_channels(),
+                        image->number_of_channels() == 3 ? GL_RGB : GL_RGBA));
+}
@@ -0,0 +1,11 @@
+#version 430 core
+layout (location = 0) in vec3 point;
+
+layout (std430) readonly buffer PointLabels {
+  uint labels[];
+};
+
+void main()
+{
+  gl_Position = vec4(point, float(labels[gl_VertexID]));
+}
@@ -1,7 +1,157 @@
 #include "gl/core/texture.h"
 #include "utils/image.h"
 
+#include "glog/logging.h"
+
+#include <algorithm>
 #include <iostream>
+#include <optional>
+
+namespace {
+
+/// Pixel format and data type that match an internal texture format.
+struct PixelFormat {
+  GLenum format{GL_NONE};
+  GLenum data_type{GL_NONE};
+};
+
+PixelFormat GetPixelFormat(gl::Texture::InternalFormat internal_format) {
+  using InternalFormat = gl::Texture::InternalFormat;
+  switch (internal_format) {
+    case InternalFormat::kR8: return {GL_RED, GL_UNSIGNED_BYTE};
+    case InternalFormat::kRG8: return {GL_RG, GL_UNSIGNED_BYTE};
+    case InternalFormat::kRGB8: return {GL_RGB, GL_UNSIGNED_BYTE};
+    case InternalFormat::kRGBA8: return {GL_RGBA, GL_UNSIGNED_BYTE};
+    case InternalFormat::kR16: return {GL_RED, GL_UNSIGNED_SHORT};
+    case InternalFormat::kRG16: return {GL_RG, GL_UNSIGNED_SHORT};
+    case InternalFormat::kRGB16: return {GL_RGB, GL_UNSIGNED_SHORT};
+    case InternalFormat::kRGBA16: return {GL_RGBA, GL_UNSIGNED_SHORT};
+    case InternalFormat::kR16F: return {GL_RED, GL_FLOAT};
+    case InternalFormat::kRG16F: return {GL_RG, GL_FLOAT};
+    case InternalFormat::kR32F: return {GL_RED, GL_FLOAT};
+    case InternalFormat::kRG32F: return {GL_RG, GL_FLOAT};
+    case InternalFormat::kRGB32F: return {GL_RGB, GL_FLOAT};
+    case InternalFormat::kRGBA32F: return {GL_RGBA, GL_FLOAT};
+    // Compressed formats are uploaded as they are.
+    default: return {};
+  }
+}
+
+/// Internal format that keeps the pixels of an image in their native form.
+std::optional<gl::Texture::InternalFormat> GetInternalFormat(
+    const utils::Image& image) {
+  using InternalFormat = gl::Texture::InternalFormat;
+  using DataType = utils::Image::DataType;
+  constexpr auto kMaxChannels{4};
+  const auto channels{image.number_of_channels()};
+  if (channels < 1 || channels > kMaxChannels) { return {}; }
+  const auto index{channels - 1};
+  switch (image.data_type()) {
+    case DataType::kUint8: {
+      constexpr InternalFormat kFormats[]{InternalFormat::kR8,
+                                          InternalFormat::kRG8,
+                                          InternalFormat::kRGB8,
+                                          InternalFormat::kRGBA8};
+      return kFormats[index];
+    }
+    case DataType::kUint16: {
+      constexpr InternalFormat kFormats[]{InternalFormat::kR16,
+                                          InternalFormat::kRG16,
+                                          InternalFormat::kRGB16,
+                                          InternalFormat::kRGBA16};
+      return kFormats[index];
+    }
+    case DataType::kFloat: {
+      constexpr InternalFormat kFormats[]{InternalFormat::kR32F,
+                                          InternalFormat::kRG32F,
+                                          InternalFormat::kRGB32F,
+                                          InternalFormat::kRGBA32F};
+      return kFormats[index];
+    }
+  }
+  return {};
+}
+
+GLenum GetGlDataType(utils::Image::DataType data_type) {
+  switch (data_type) {
+    case utils::Image::DataType::kUint8: return GL_UNSIGNED_BYTE;
+    case utils::Image::DataType::kUint16: return GL_UNSIGNED_SHORT;
+    case utils::Image::DataType::kFloat: return GL_FLOAT;
+  }
+  return GL_NONE;
+}
+
+/// Size of a mip level along one dimension.
+int GetLevelSize(int size, int level) { return std::max(1, size >> level); }
+
+/// Show formats with one channel as gray and with two as gray with alpha.
+/// All other formats are shown as they are, which also undoes the swizzle of
+/// a gray image that the texture held before.
+void SetSwizzle(GLenum target, gl::Texture::InternalFormat internal_format) {
+  const auto format{GetPixelFormat(internal_format).format};
+  const GLint kGray[]{GL_RED, GL_RED, GL_RED, GL_ONE};
+  const GLint kGrayAlpha[]{GL_RED, GL_RED, GL_RED, GL_GREEN};
+  const GLint kIdentity[]{GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+  const GLint* swizzle{kIdentity};
+  if (format == GL_RED) { swizzle = kGray; }
+  if (format == GL_RG) { swizzle = kGrayAlpha; }
+  glTexParameteriv(target, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+}
+
+/// RAII helper that sets the unpack alignment to 1 for tightly packed pixels.
+class TightUnpackAlignment {
+ public:
+  TightUnpackAlignment() {
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &previous_alignment_);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  }
+  ~TightUnpackAlignment() {
+    glPixelStorei(GL_UNPACK_ALIGNMENT, previous_alignment_);
+  }
+
+ private:
+  GLint previous_alignment_{};
+};
+
+GLenum GetTextureBufferFormat(GLint gl_type, GLint components) {
+  constexpr auto kMaxComponents{4};
+  if (components < 1 || components > kMaxComponents) { return GL_NONE; }
+  const auto index{components - 1};
+  switch (gl_type) {
+    case GL_FLOAT: {
+      constexpr GLenum kFormats[]{GL_R32F, GL_RG32F, GL_RGB32F, GL_RGBA32F};
+      return kFormats[index];
+    }
+    case GL_INT: {
+      constexpr GLenum kFormats[]{GL_R32I, GL_RG32I, GL_RGB32I, GL_RGBA32I};
+      return kFormats[index];
+    }
+    case GL_UNSIGNED_INT: {
+      constexpr GLenum kFormats[]{
+          GL_R32UI, GL_RG32UI, GL_RGB32UI, GL_RGBA32UI};
+      return kFormats[index];
+    }
+    case GL_SHORT: {
+      constexpr GLenum kFormats[]{GL_R16I, GL_RG16I, GL_NONE, GL_RGBA16I};
+      return kFormats[index];
+    }
+    case GL_UNSIGNED_SHORT: {
+      constexpr GLenum kFormats[]{GL_R16UI, GL_RG16UI, GL_NONE, GL_RGBA16UI};
+      return kFormats[index];
+    }
+    case GL_BYTE: {
+      constexpr GLenum kFormats[]{GL_R8I, GL_RG8I, GL_NONE, GL_RGBA8I};
+      return kFormats[index];
+    }
+    case GL_UNSIGNED_BYTE: {
+      constexpr GLenum kFormats[]{GL_R8UI, GL_RG8UI, GL_NONE, GL_RGBA8UI};
+      return kFormats[index];
+    }
+  }
+  return GL_NONE;
+}
+
+}  // namespace
 
 namespace gl {
 
@@ -31,24 +181,355 @@ void Texture::SetImage(const utils::Image& image, int level_of_detail) {
     std::cerr << "No data in the image." << std::endl;
     return;
   }
-  GLenum color_mode = 0;
-  switch (image.number_of_channels()) {
-    case 3: color_mode = GL_RGB; break;
-    case 4: color_mode = GL_RGBA; break;
-    default: return;
-  }
-  glTexImage2D(static_cast<GLenum>(texture_type_),
-               level_of_detail,
-               GL_RGBA,
-               image.width(),
-               image.height(),
-               0,  // Legacy stuff. Was border before.
-               color_mode,
-               GL_UNSIGNED_BYTE,
-               image.data());
+  const auto internal_format{GetInternalFormat(image)};
+  if (!internal_format) {
+    LOG(WARNING) << "Unsupported number of channels: "
+                 << image.number_of_channels();
+    return;
+  }
+  const auto pixel_format{GetPixelFormat(internal_format.value())};
+  const auto data_type{GetGlDataType(image.data_type())};
+  if (has_allocated_storage_) {
+    CHECK_EQ(level_of_detail, 0) << "Can only write into the level 0.";
+    CHECK_EQ(image.width(), width_) << "Image does not fit the storage.";
+    CHECK_EQ(image.height(), height_) << "Image does not fit the storage.";
+    CHECK_EQ(GetPixelFormat(internal_format_).format, pixel_format.format)
+        << "Image channels do not match the storage format.";
+    UpdateRegionFromData(
+        0, 0, width_, height_, data_type, image.data(), false);
+    GenerateMipmaps();
+    return;
+  }
+  const auto target{static_cast<GLenum>(texture_type_)};
+  {
+    // Rows of images with 1 to 3 channels are not always 4-byte aligned.
+    const TightUnpackAlignment tight_unpack_alignment{};
+    glTexImage2D(target,
+                 level_of_detail,
+                 static_cast<GLint>(internal_format.value()),
+                 image.width(),
+                 image.height(),
+                 0,  // Legacy stuff. Was border before.
+                 pixel_format.format,
+                 data_type,
+                 image.data());
+  }
+  SetSwizzle(target, internal_format.value());
+  glGenerateMipmap(target);
+  if (level_of_detail == 0) {
+    width_ = image.width();
+    height_ = image.height();
+    number_of_levels_ = ComputeNumberOfMipmapLevels(width_, height_);
+    internal_format_ = internal_format.value();
+  }
+}
+
+void Texture::SetCompressedImage(const utils::CompressedImage& image) {
+  CHECK(texture_type_ == Type::kTexture2D)
+      << "Compressed images can only be set to 2D textures.";
+  CHECK(!has_allocated_storage_) << "Texture storage is already allocated.";
+  const auto target{static_cast<GLenum>(texture_type_)};
+  const auto& levels{image.levels()};
+  for (std::size_t level = 0; level < levels.size(); ++level) {
+    glCompressedTexImage2D(target,
+                           level,
+                           image.internal_format(),
+                           levels[level].width,
+                           levels[level].height,
+                           0,  // Legacy stuff. Was border before.
+                           levels[level].size,
+                           image.level_data(level));
+  }
+  // Without this the texture is incomplete if the file has no full mip chain.
+  glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels.size() - 1);
+  // Compressed formats are shown as they are.
+  SetSwizzle(target, static_cast<InternalFormat>(image.internal_format()));
+  width_ = image.width();
+  height_ = image.height();
+  number_of_levels_ = levels.size();
+  internal_format_ = static_cast<InternalFormat>(image.internal_format());
+}
+
+void Texture::SetImagePyramid(const std::vector<utils::Image>& levels) {
+  CHECK(texture_type_ == Type::kTexture2D)
+      << "Image pyramids can only be set to 2D textures.";
+  CHECK(!has_allocated_storage_) << "Texture storage is already allocated.";
+  CHECK(!levels.empty()) << "Need at least one level.";
+  const auto& first_level{levels.front()};
+  const auto internal_format{GetInternalFormat(first_level)};
+  CHECK(internal_format)
+      << "Unsupported number of channels: " << first_level.number_of_channels();
+  const auto pixel_format{GetPixelFormat(internal_format.value())};
+  const auto target{static_cast<GLenum>(texture_type_)};
+  {
+    const TightUnpackAlignment tight_unpack_alignment{};
+    for (std::size_t level = 0; level < levels.size(); ++level) {
+      const auto& image{levels[level]};
+      CHECK_EQ(image.width(), GetLevelSize(first_level.width(), level))
+          << "Wrong size of the level " << level;
+      CHECK_EQ(image.height(), GetLevelSize(first_level.height(), level))
+          << "Wrong size of the level " << level;
+      CHECK(image.number_of_channels() == first_level.number_of_channels() &&
+            image.data_type() == first_level.data_type())
+          << "All levels must have the same pixel format.";
+      glTexImage2D(target,
+                   level,
+                   static_cast<GLint>(internal_format.value()),
+                   image.width(),
+                   image.height(),
+                   0,  // Legacy stuff. Was border before.
+                   pixel_format.format,
+                   pixel_format.data_type,
+                   image.data());
+    }
+  }
+  SetSwizzle(target, internal_format.value());
+  glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels.size() - 1);
+  width_ = first_level.width();
+  height_ = first_level.height();
+  number_of_levels_ = levels.size();
+  internal_format_ = internal_format.value();
+}
+
+bool Texture::IsCompressedFormatSupported(GLenum internal_format) {
+  if (GLAD_GL_VERSION_4_3) {
+    GLint supported{};
+    glGetInternalformativ(GL_TEXTURE_2D,
+                          internal_format,
+                          GL_INTERNALFORMAT_SUPPORTED,
+                          1,
+                          &supported);
+    return supported == GL_TRUE;
+  }
+  // This list only has to contain general-purpose formats, so specialized
+  // formats like BC4 might be missing in it even if they are supported.
+  GLint number_of_formats{};
+  glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &number_of_formats);
+  std::vector<GLint> formats(number_of_formats);
+  glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+  return std::find(formats.cbegin(),
+                   formats.cend(),
+                   static_cast<GLint>(internal_format)) != formats.cend();
+}
+
+void Texture::SetImageLayers(const std::vector<utils::Image>& images) {
+  CHECK(texture_type_ == Type::kTexture2DArray)
+      << "Image layers can only be set to 2D array textures.";
+  CHECK(!has_allocated_storage_) << "Texture storage is already allocated.";
+  CHECK(!images.empty()) << "Need at least one image.";
+  const auto& first_image{images.front()};
+  const auto maybe_internal_format{GetInternalFormat(first_image)};
+  CHECK(maybe_internal_format)
+      << "Unsupported number of channels: " << first_image.number_of_channels();
+  const auto internal_format{maybe_internal_format.value()};
+  for (const auto& image : images) {
+    CHECK_EQ(image.width(), first_image.width())
+        << "All layers must have the same size.";
+    CHECK_EQ(image.height(), first_image.height())
+        << "All layers must have the same size.";
+    CHECK_EQ(image.number_of_channels(), first_image.number_of_channels())
+        << "All layers must have the same number of channels.";
+    CHECK(image.data_type() == first_image.data_type())
+        << "All layers must have the same data type.";
+    CHECK(image.data() != nullptr) << "No data in the image.";
+  }
+  const auto target{static_cast<GLenum>(texture_type_)};
+  const auto pixel_format{GetPixelFormat(internal_format)};
+  const auto number_of_layers{static_cast<GLsizei>(images.size())};
+  const int number_of_levels{ComputeNumberOfMipmapLevels(first_image.width(),
+                                                         first_image.height())};
+  if (GLAD_GL_VERSION_4_2) {
+    glTexStorage3D(target,
+                   number_of_levels,
+                   static_cast<GLenum>(internal_format),
+                   first_image.width(),
+                   first_image.height(),
+                   number_of_layers);
+    has_immutable_storage_ = true;
+  } else {
+    glTexImage3D(target,
+                 0,
+                 static_cast<GLint>(internal_format),
+                 first_image.width(),
+                 first_image.height(),
+                 number_of_layers,
+                 0,  // Legacy stuff. Was border before.
+                 pixel_format.format,
+                 pixel_format.data_type,
+                 nullptr);
+  }
+  {
+    const TightUnpackAlignment tight_unpack_alignment{};
+    for (GLsizei layer = 0; layer < number_of_layers; ++layer) {
+      glTexSubImage3D(target,
+                      0,
+                      0,
+                      0,
+                      layer,
+                      first_image.width(),
+                      first_image.height(),
+                      1,
+                      pixel_format.format,
+                      pixel_format.data_type,
+                      images[layer].data());
+    }
+  }
+  SetSwizzle(target, internal_format);
+  glGenerateMipmap(target);
+  width_ = first_image.width();
+  height_ = first_image.height();
+  number_of_levels_ = number_of_levels;
+  number_of_layers_ = number_of_layers;
+  internal_format_ = internal_format;
+  has_allocated_storage_ = true;
+}
+
+void Texture::AllocateStorage(int width,
+                              int height,
+                              int number_of_levels,
+                              InternalFormat internal_format) {
+  CHECK(texture_type_ == Type::kTexture2D)
+      << "Storage can only be allocated for 2D textures.";
+  CHECK(!has_allocated_storage_) << "Texture storage is already allocated.";
+  CHECK_GT(width, 0) << "Texture must not be empty.";
+  CHECK_GT(height, 0) << "Texture must not be empty.";
+  CHECK_GT(number_of_levels, 0) << "Texture needs at least one level.";
+  CHECK_LE(number_of_levels, ComputeNumberOfMipmapLevels(width, height))
+      << "Too many mip levels for this texture size.";
+  const auto target{static_cast<GLenum>(texture_type_)};
+  if (GLAD_GL_VERSION_4_2) {
+    glTexStorage2D(target,
+                   number_of_levels,
+                   static_cast<GLenum>(internal_format),
+                   width,
+                   height);
+    has_immutable_storage_ = true;
+  } else {
+    const auto pixel_format{GetPixelFormat(internal_format)};
+    for (int level = 0; level < number_of_levels; ++level) {
+      glTexImage2D(target,
+                   level,
+                   static_cast<GLint>(internal_format),
+                   GetLevelSize(width, level),
+                   GetLevelSize(height, level),
+                   0,  // Legacy stuff. Was border before.
+                   pixel_format.format,
+                   pixel_format.data_type,
+                   nullptr);
+    }
+    // Without this the texture is incomplete if not all levels are allocated.
+    glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, number_of_levels - 1);
+  }
+  // Later updates of regions keep the format, so they keep the swizzle too.
+  SetSwizzle(target, internal_format);
+  width_ = width;
+  height_ = height;
+  number_of_levels_ = number_of_levels;
+  internal_format_ = internal_format;
+  has_allocated_storage_ = true;
+}
+
+void Texture::UpdateRegionFromData(int x,
+                                   int y,
+                                   int width,
+                                   int height,
+                                   GLenum data_type,
+                                   const void* const data,
+                                   bool update_mipmaps) {
+  CHECK_GE(x, 0) << "Region is out of the texture bounds.";
+  CHECK_GE(y, 0) << "Region is out of the texture bounds.";
+  CHECK_LE(x + width, width_) << "Region is out of the texture bounds.";
+  CHECK_LE(y + height, height_) << "Region is out of the texture bounds.";
+  if (width <= 0 || height <= 0) { return; }
+  {
+    const TightUnpackAlignment tight_unpack_alignment{};
+    glTexSubImage2D(static_cast<GLenum>(texture_type_),
+                    0,
+                    x,
+                    y,
+                    width,
+                    height,
+                    GetPixelFormat(internal_format_).format,
+                    data_type,
+                    data);
+  }
+  if (update_mipmaps) { UpdateMipmapsInRegion(x, y, width, height); }
+}
+
+void Texture::UpdateMipmapsInRegion(int x, int y, int width, int height) {
+  if (number_of_levels_ < 2 || width <= 0 || height <= 0) { return; }
+  GLint previous_read_framebuffer{};
+  GLint previous_draw_framebuffer{};
+  glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previous_read_framebuffer);
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous_draw_framebuffer);
+  const bool scissor_test_enabled{glIsEnabled(GL_SCISSOR_TEST) == GL_TRUE};
+  if (scissor_test_enabled) { glDisable(GL_SCISSOR_TEST); }
+
+  GLuint framebuffers[2]{};
+  glGenFramebuffers(2, framebuffers);
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[0]);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[1]);
+  const auto target{static_cast<GLenum>(texture_type_)};
+  // Bounds of the changed region in the previous level. Max values are
+  // exclusive.
+  int min_x{x};
+  int min_y{y};
+  int max_x{x + width};
+  int max_y{y + height};
+  for (int level = 1; level < number_of_levels_; ++level) {
+    const int level_width{GetLevelSize(width_, level)};
+    const int level_height{GetLevelSize(height_, level)};
+    min_x /= 2;
+    min_y /= 2;
+    max_x = std::min(level_width, (max_x + 1) / 2);
+    max_y = std::min(level_height, (max_y + 1) / 2);
+    const int previous_level_width{GetLevelSize(width_, level - 1)};
+    const int previous_level_height{GetLevelSize(height_, level - 1)};
+    glFramebufferTexture2D(
+        GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, id_, level - 1);
+    glFramebufferTexture2D(
+        GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, target, id_, level);
+    glBlitFramebuffer(2 * min_x,
+                      2 * min_y,
+                      std::min(previous_level_width, 2 * max_x),
+                      std::min(previous_level_height, 2 * max_y),
+                      min_x,
+                      min_y,
+                      max_x,
+                      max_y,
+                      GL_COLOR_BUFFER_BIT,
+                      GL_LINEAR);
+  }
+
+  glBindFramebuffer(GL_READ_FRAMEBUFFER, previous_read_framebuffer);
+  glBindFramebuffer(GL_DRAW_FRAMEBUFFER, previous_draw_framebuffer);
+  glDeleteFramebuffers(2, framebuffers);
+  if (scissor_test_enabled) { glEnable(GL_SCISSOR_TEST); }
+}
+
+void Texture::GenerateMipmaps() {
+  if (number_of_levels_ < 2) { return; }
   glGenerateMipmap(static_cast<GLenum>(texture_type_));
 }
 
+int Texture::ComputeNumberOfMipmapLevels(int width, int height) {
+  int number_of_levels{1};
+  for (int size = std::max(width, height); size > 1; size /= 2) {
+    ++number_of_levels;
+  }
+  return number_of_levels;
+}
+
+void Texture::SetBuffer(const Buffer& buffer) {
+  CHECK(texture_type_ == Texture::Type::kTextureBuffer)
+      << "Only buffer textures can be backed by a buffer.";
+  const auto internal_format{GetTextureBufferFormat(
+      buffer.gl_underlying_data_type(), buffer.components_per_vertex())};
+  CHECK_NE(internal_format, static_cast<GLenum>(GL_NONE))
+      << "Buffer data cannot be represented as a texture buffer.";
+  glTexBuffer(static_cast<GLenum>(texture_type_), internal_format, buffer.id());
+}
+
 Texture::Builder::Builder(Type type, Identifier identifier)
     : texture_{std::make_unique<Texture>(type, identifier)} {
   texture_->Bind();
@@ -83,6 +564,33 @@ Texture::Builder& Texture::Builder::WithImage(const utils::Image& image,
   texture_->SetImage(image, level_of_detail);
   return *this;
 }
+Texture::Builder& Texture::Builder::WithBuffer(const Buffer& buffer) {
+  texture_->SetBuffer(buffer);
+  return *this;
+}
+Texture::Builder& Texture::Builder::WithImageLayers(
+    const std::vector<utils::Image>& images) {
+  texture_->SetImageLayers(images);
+  return *this;
+}
+Texture::Builder& Texture::Builder::WithCompressedImage(
+    const utils::CompressedImage& image) {
+  texture_->SetCompressedImage(image);
+  return *this;
+}
+Texture::Builder& Texture::Builder::WithImagePyramid(
+    const std::vector<utils::Image>& levels) {
+  texture_->SetImagePyramid(levels);
+  return *this;
+}
+Texture::Builder& Texture::Builder::WithStorage(
+    int width,
+    int height,
+    int number_of_levels,
+    InternalFormat internal_format) {
+  texture_->AllocateStorage(width, height, number_of_levels, internal_format);
+  return *this;
+}
 std::unique_ptr<Texture> Texture::Builder::Build() {
   texture_->UnBind();
   return std::move(texture_);
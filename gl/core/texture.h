@@ -1,10 +1,15 @@
 #ifndef CODE_OPENGL_TUTORIALS_GL_CORE_TEXTURE_H_
 #define CODE_OPENGL_TUTORIALS_GL_CORE_TEXTURE_H_
 
+#include "gl/core/buffer.h"
 #include "gl/core/opengl_object.h"
+#include "utils/compressed_image.h"
 #include "utils/image.h"
 
+#include <array>
+#include <cstdint>
 #include <iostream>
+#include <vector>
 
 namespace gl {
 
@@ -16,6 +21,7 @@ class Texture : public OpenGlObject {
   enum class FilteringType : GLenum;
   enum class FilteringMode : GLint;
   enum class WrappingMode : GLint;
+  enum class InternalFormat : GLenum;
 
   class Builder {
    public:
@@ -27,6 +33,14 @@ class Texture : public OpenGlObject {
     Builder& WithFiltering(FilteringType filtering_type,
                            FilteringMode filtering_mode);
     Builder& WithImage(const utils::Image& image, int level_of_detail = 0);
+    Builder& WithBuffer(const Buffer& buffer);
+    Builder& WithImageLayers(const std::vector<utils::Image>& images);
+    Builder& WithCompressedImage(const utils::CompressedImage& image);
+    Builder& WithImagePyramid(const std::vector<utils::Image>& levels);
+    Builder& WithStorage(int width,
+                         int height,
+                         int number_of_levels,
+                         InternalFormat internal_format);
     std::unique_ptr<Texture> Build();
 
    private:
@@ -38,12 +52,35 @@ class Texture : public OpenGlObject {
     glGenTextures(1, &id_);
   }
 
+  Texture(const Texture&) = delete;
+  Texture& operator=(const Texture&) = delete;
+
+  ~Texture() {
+    if (id_) { glDeleteTextures(1, &id_); }
+  }
+
+  /// Bind the texture to the unit of its identifier.
   inline void Bind() {
     glActiveTexture(static_cast<GLenum>(texture_identifier_));
     glBindTexture(static_cast<GLenum>(texture_type_), id_);
+    CountBindOnUnit();
+  }
+
+  /// Unbind any texture of this type from the unit of the identifier.
+  inline void UnBind() {
+    glActiveTexture(static_cast<GLenum>(texture_identifier_));
+    glBindTexture(static_cast<GLenum>(texture_type_), 0);
+    CountBindOnUnit();
   }
 
-  inline void UnBind() { glBindTexture(static_cast<GLenum>(texture_type_), 0); }
+  /// Number of texture units an identifier can name.
+  static constexpr int kNumberOfIdentifiers{32};
+
+  /// Number of times Bind or UnBind changed what is bound to the unit. This
+  /// lets a TextureUnitAllocator notice binds that did not go through it.
+  static std::uint64_t number_of_binds_on_unit(int unit) {
+    return binds_on_unit_.at(unit);
+  }
 
   void SetWrapping(WrappingDirection wrapping_direction,
                    WrappingMode wrapping_mode,
@@ -51,11 +88,143 @@ class Texture : public OpenGlObject {
 
   void SetFiltering(FilteringType filtering_type, FilteringMode filtering_mode);
 
+  /// Set the image to the texture. The pixels keep their number of channels
+  /// and data type, e.g., a 16-bit depth image becomes an R16 texture.
+  /// Images with one or two channels are sampled as gray and gray with alpha.
+  /// If the storage of the texture was allocated with AllocateStorage, the
+  /// image is written into it instead.
   void SetImage(const utils::Image& image, int level_of_detail = 0);
 
+  /// Upload an image that is already compressed, e.g., read from a KTX file,
+  /// with all of its mip levels. Compressed textures take 4 to 8 times less
+  /// memory than RGBA ones. The texture must be bound.
+  void SetCompressedImage(const utils::CompressedImage& image);
+
+  /// Upload all mip levels that were computed beforehand, e.g., with
+  /// utils::BuildMipmapPyramid on a worker thread, instead of generating them
+  /// with glGenerateMipmap. Every level must be half the size of the previous
+  /// one, rounded down. The texture must be bound.
+  void SetImagePyramid(const std::vector<utils::Image>& levels);
+
+  /// Check if the OpenGL implementation can use this compressed format.
+  static bool IsCompressedFormatSupported(GLenum internal_format);
+
+  /// Put each image into its own layer of a texture of type kTexture2DArray.
+  /// The layer index matches the index of the image. All images must have
+  /// the same size and number of channels. The texture must be bound.
+  void SetImageLayers(const std::vector<utils::Image>& images);
+
+  /// Allocate immutable storage for a 2D texture with a given number of mip
+  /// levels. The contents are undefined until written with UpdateRegion.
+  /// Needs OpenGL 4.2, otherwise falls back to allocating each level with
+  /// glTexImage2D. The texture must be bound.
+  void AllocateStorage(int width,
+                       int height,
+                       int number_of_levels,
+                       InternalFormat internal_format);
+
+  /// Write a rectangle of tightly packed pixels into the level 0 of the
+  /// texture. The number of channels follows the internal format of the
+  /// texture. If update_mipmaps is true, only the part of the mip levels that
+  /// depends on this region is regenerated. The texture must be bound.
+  ///
+  /// If a pixel unpack buffer is bound, data is an offset into that buffer.
+  template <typename T>
+  void UpdateRegion(int x,
+                    int y,
+                    int width,
+                    int height,
+                    const T* const data,
+                    bool update_mipmaps = false) {
+    static_assert(::traits::has_value_member<
+                      typename traits::gl_underlying_type<T>>::value,
+                  "Missing specialization for trait 'gl_underlying_type'");
+    UpdateRegionFromData(x,
+                         y,
+                         width,
+                         height,
+                         traits::gl_underlying_type<T>::value,
+                         static_cast<const void*>(data),
+                         update_mipmaps);
+  }
+
+  /// Regenerate the part of all mip levels that depends on a region of the
+  /// level 0. Each level is downsampled from the previous one by a linear
+  /// blit, which averages 2x2 blocks of pixels.
+  void UpdateMipmapsInRegion(int x, int y, int width, int height);
+
+  /// Regenerate all mip levels from the level 0.
+  void GenerateMipmaps();
+
+  /// Number of levels needed for a full mip chain of an image of this size.
+  static int ComputeNumberOfMipmapLevels(int width, int height);
+
+  /// Use the data store of a buffer as the texels of this texture. Only valid
+  /// for textures of type kTextureBuffer. The texel format is guessed from the
+  /// type of the data stored in the buffer.
+  void SetBuffer(const Buffer& buffer);
+
+  inline Type type() const noexcept { return texture_type_; }
+  inline int width() const noexcept { return width_; }
+  inline int height() const noexcept { return height_; }
+  inline int number_of_levels() const noexcept { return number_of_levels_; }
+  inline int number_of_layers() const noexcept { return number_of_layers_; }
+  inline bool has_immutable_storage() const noexcept {
+    return has_immutable_storage_;
+  }
+  inline InternalFormat internal_format() const noexcept {
+    return internal_format_;
+  }
+
  private:
+  void UpdateRegionFromData(int x,
+                            int y,
+                            int width,
+                            int height,
+                            GLenum data_type,
+                            const void* const data,
+                            bool update_mipmaps);
+
+  inline void CountBindOnUnit() {
+    ++binds_on_unit_[static_cast<GLenum>(texture_identifier_) - GL_TEXTURE0];
+  }
+
+  static inline std::array<std::uint64_t, kNumberOfIdentifiers>
+      binds_on_unit_{};
+
   Type texture_type_{};
   Identifier texture_identifier_{};
+
+  int width_{};
+  int height_{};
+  int number_of_levels_{};
+  int number_of_layers_{};
+  InternalFormat internal_format_{};
+  bool has_allocated_storage_{};
+  bool has_immutable_storage_{};
+};
+
+enum class Texture::InternalFormat : GLenum {
+  kR8 = GL_R8,
+  kRG8 = GL_RG8,
+  kRGB8 = GL_RGB8,
+  kRGBA8 = GL_RGBA8,
+  kR16 = GL_R16,
+  kRG16 = GL_RG16,
+  kRGB16 = GL_RGB16,
+  kRGBA16 = GL_RGBA16,
+  kR16F = GL_R16F,
+  kRG16F = GL_RG16F,
+  kR32F = GL_R32F,
+  kRG32F = GL_RG32F,
+  kRGB32F = GL_RGB32F,
+  kRGBA32F = GL_RGBA32F,
+  kCompressedRgbBc1 = GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+  kCompressedRgbaBc1 = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,
+  kCompressedRgbaBc3 = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,
+  kCompressedRedBc4 = GL_COMPRESSED_RED_RGTC1,
+  kCompressedRgBc5 = GL_COMPRESSED_RG_RGTC2,
+  kCompressedRgbaBc7 = GL_COMPRESSED_RGBA_BPTC_UNORM,
 };
 
 enum class Texture::FilteringType : GLenum {
@@ -77,7 +246,9 @@ enum class Texture::WrappingDirection : GLenum {
 enum class Texture::Type : GLenum {
   kTexture1D = GL_TEXTURE_1D,
   kTexture2D = GL_TEXTURE_2D,
-  kTexture3D = GL_TEXTURE_3D
+  kTexture3D = GL_TEXTURE_3D,
+  kTexture2DArray = GL_TEXTURE_2D_ARRAY,
+  kTextureBuffer = GL_TEXTURE_BUFFER
 };
 
 enum class Texture::WrappingMode : GLint {
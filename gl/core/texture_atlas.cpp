@@ -0,0 +1,94 @@
+#include "gl/core/texture_atlas.h"
+#include "utils/skyline_packer.h"
+
+#include "glog/logging.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+constexpr int kAtlasChannels{4};
+
+/// Copy an image into the atlas pixels, repeating its edge pixels into the
+/// padding around it.
+void CopyWithPadding(const utils::Image& image,
+                     int x,
+                     int y,
+                     int padding,
+                     utils::Image* atlas) {
+  const int channels{image.number_of_channels()};
+  const int padded_width{image.width() + 2 * padding};
+  const int padded_height{image.height() + 2 * padding};
+  for (int row = 0; row < padded_height; ++row) {
+    const int source_row{std::clamp(row - padding, 0, image.height() - 1)};
+    for (int col = 0; col < padded_width; ++col) {
+      const int source_col{std::clamp(col - padding, 0, image.width() - 1)};
+      const auto* const source{
+          image.data() + (source_row * image.width() + source_col) * channels};
+      auto* const target{
+          atlas->data() +
+          ((y + row) * atlas->width() + x + col) * kAtlasChannels};
+      std::copy(source, source + channels, target);
+      if (channels < kAtlasChannels) { target[3] = 255; }
+    }
+  }
+}
+
+}  // namespace
+
+namespace gl {
+
+std::optional<TextureAtlas> TextureAtlas::CreateFromImages(
+    const std::vector<utils::Image>& images,
+    int width,
+    int height,
+    Texture::Identifier identifier,
+    int padding) {
+  CHECK_GE(padding, 0) << "Padding cannot be negative.";
+  for (const auto& image : images) {
+    CHECK(image.data() != nullptr) << "No data in the image.";
+    CHECK(image.data_type() == utils::Image::DataType::kUint8)
+        << "Only 8-bit images can be packed into an atlas.";
+    CHECK(image.number_of_channels() == 3 || image.number_of_channels() == 4)
+        << "Unsupported number of channels: " << image.number_of_channels();
+  }
+  // Packing the highest images first leaves smaller gaps in the skyline.
+  std::vector<std::size_t> order(images.size());
+  std::iota(order.begin(), order.end(), 0ul);
+  std::stable_sort(order.begin(), order.end(), [&images](auto lhs, auto rhs) {
+    return images[lhs].height() > images[rhs].height();
+  });
+
+  utils::SkylinePacker packer{width, height};
+  auto pixels{utils::Image::CreateFromData(width, height, kAtlasChannels)};
+  TextureAtlas atlas{};
+  atlas.uv_rects_.resize(images.size());
+  for (const auto index : order) {
+    const auto& image{images[index]};
+    const auto position{packer.Insert(image.width() + 2 * padding,
+                                      image.height() + 2 * padding)};
+    if (!position) { return {}; }
+    CopyWithPadding(image, position->x, position->y, padding, &pixels);
+    const float min_x = position->x + padding;
+    const float min_y = position->y + padding;
+    atlas.uv_rects_[index] = {min_x / width,
+                              min_y / height,
+                              (min_x + image.width()) / width,
+                              (min_y + image.height()) / height};
+  }
+
+  atlas.texture_ =
+      Texture::Builder{Texture::Type::kTexture2D, identifier}
+          .WithSaneDefaults()
+          .WithWrapping(Texture::WrappingDirection::kWrapS,
+                        Texture::WrappingMode::kClampToEdge)
+          .WithWrapping(Texture::WrappingDirection::kWrapT,
+                        Texture::WrappingMode::kClampToEdge)
+          .WithStorage(width, height, 1, Texture::InternalFormat::kRGBA8)
+          .WithImage(pixels)
+          .Build();
+  return atlas;
+}
+
+}  // namespace gl
@@ -0,0 +1,59 @@
+#ifndef OPENGL_TUTORIALS_CORE_TEXTURE_ATLAS_H_
+#define OPENGL_TUTORIALS_CORE_TEXTURE_ATLAS_H_
+
+#include "gl/core/texture.h"
+#include "utils/image.h"
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace gl {
+
+/// A single texture that holds many images.
+///
+/// Drawing many small images, e.g., icons or thumbnails, from one texture
+/// avoids binding a separate texture for each of them. Every image is then
+/// addressed by its rectangle in texture coordinates.
+class TextureAtlas {
+ public:
+  /// Part of the atlas occupied by one image in texture coordinates.
+  struct UvRect {
+    float min_u{};
+    float min_v{};
+    float max_u{1.0F};
+    float max_v{1.0F};
+  };
+
+  /// Pack the images into an RGBA atlas of a given size. Every image is
+  /// surrounded by a border of padding pixels that repeat its edge pixels, so
+  /// that linear filtering does not mix neighboring images. Returns an empty
+  /// optional if the images do not fit.
+  static std::optional<TextureAtlas> CreateFromImages(
+      const std::vector<utils::Image>& images,
+      int width,
+      int height,
+      Texture::Identifier identifier,
+      int padding = 1);
+
+  inline const std::shared_ptr<Texture>& texture() const noexcept {
+    return texture_;
+  }
+
+  /// The rectangle of the image with a given index in the input images.
+  inline const UvRect& uv_rect(std::size_t image_index) const noexcept {
+    return uv_rects_[image_index];
+  }
+
+  inline std::size_t size() const noexcept { return uv_rects_.size(); }
+
+ private:
+  TextureAtlas() = default;
+
+  std::shared_ptr<Texture> texture_{};
+  std::vector<UvRect> uv_rects_{};
+};
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_CORE_TEXTURE_ATLAS_H_
@@ -0,0 +1,66 @@
+#include "gl/core/texture_atlas.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace gl;
+
+namespace {
+utils::Image CreateFilledImage(int width,
+                               int height,
+                               int channels,
+                               std::uint8_t value) {
+  const std::vector<std::uint8_t> data(width * height * channels, value);
+  return utils::Image::CreateFromData(width, height, channels, data.data());
+}
+}  // namespace
+
+TEST(TextureAtlasTest, PackImages) {
+  const std::vector<utils::Image> images{CreateFilledImage(4, 2, 3, 10),
+                                         CreateFilledImage(3, 5, 4, 20),
+                                         CreateFilledImage(6, 6, 3, 30)};
+  const int width{16};
+  const int height{16};
+  const auto atlas{TextureAtlas::CreateFromImages(
+      images, width, height, Texture::Identifier::kTexture0)};
+  ASSERT_TRUE(atlas.has_value());
+  ASSERT_NE(atlas->texture(), nullptr);
+  ASSERT_EQ(images.size(), atlas->size());
+
+  std::vector<std::uint8_t> pixels(width * height * 4);
+  atlas->texture()->Bind();
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+  atlas->texture()->UnBind();
+
+  for (std::size_t i = 0; i < images.size(); ++i) {
+    const auto& rect{atlas->uv_rect(i)};
+    const int min_x = rect.min_u * width;
+    const int min_y = rect.min_v * height;
+    const int max_x = rect.max_u * width;
+    const int max_y = rect.max_v * height;
+    const std::uint8_t expected_alpha =
+        images[i].number_of_channels() == 4 ? images[i].data()[3] : 255;
+    EXPECT_EQ(images[i].width(), max_x - min_x);
+    EXPECT_EQ(images[i].height(), max_y - min_y);
+    // Check the image together with its one pixel wide padding.
+    for (int y = min_y - 1; y <= max_y; ++y) {
+      for (int x = min_x - 1; x <= max_x; ++x) {
+        const auto* const pixel{&pixels[(y * width + x) * 4]};
+        EXPECT_EQ(images[i].data()[0], pixel[0]);
+        EXPECT_EQ(expected_alpha, pixel[3]);
+      }
+    }
+  }
+}
+
+TEST(TextureAtlasTest, ImagesDoNotFit) {
+  const std::vector<utils::Image> images{CreateFilledImage(8, 8, 3, 0),
+                                         CreateFilledImage(8, 8, 3, 0)};
+  EXPECT_FALSE(TextureAtlas::CreateFromImages(
+                   images, 16, 8, Texture::Identifier::kTexture0)
+                   .has_value());
+  EXPECT_TRUE(TextureAtlas::CreateFromImages(
+                  images, 16, 8, Texture::Identifier::kTexture0, 0)
+                  .has_value());
+}
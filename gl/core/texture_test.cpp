@@ -0,0 +1,221 @@
+#include "gl/core/texture.h"
+#include "gtest/gtest.h"
+#include "utils/ktx_test_utils.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace gl;
+
+namespace {
+std::vector<std::uint8_t> ReadLevel(int level, int width, int height) {
+  std::vector<std::uint8_t> pixels(width * height);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(GL_TEXTURE_2D, level, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+  return pixels;
+}
+}  // namespace
+
+TEST(TextureTest, ComputeNumberOfMipmapLevels) {
+  EXPECT_EQ(1, Texture::ComputeNumberOfMipmapLevels(1, 1));
+  EXPECT_EQ(3, Texture::ComputeNumberOfMipmapLevels(4, 4));
+  EXPECT_EQ(4, Texture::ComputeNumberOfMipmapLevels(5, 8));
+  EXPECT_EQ(11, Texture::ComputeNumberOfMipmapLevels(1024, 3));
+}
+
+TEST(TextureTest, AllocateStorage) {
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithStorage(8, 4, 3, Texture::InternalFormat::kR8)
+                     .Build();
+  EXPECT_EQ(8, texture->width());
+  EXPECT_EQ(4, texture->height());
+  EXPECT_EQ(3, texture->number_of_levels());
+  EXPECT_EQ(Texture::InternalFormat::kR8, texture->internal_format());
+  EXPECT_TRUE(texture->has_immutable_storage());
+  texture->Bind();
+  GLint immutable{};
+  glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_IMMUTABLE_FORMAT, &immutable);
+  EXPECT_EQ(GL_TRUE, immutable);
+  texture->UnBind();
+}
+
+TEST(TextureTest, UpdateRegion) {
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithStorage(3, 3, 1, Texture::InternalFormat::kR8)
+                     .Build();
+  texture->Bind();
+  const std::vector<std::uint8_t> zeros(9, 0);
+  texture->UpdateRegion(0, 0, 3, 3, zeros.data());
+  const std::vector<std::uint8_t> region{1, 2, 3, 4};
+  texture->UpdateRegion(1, 1, 2, 2, region.data());
+  const std::vector<std::uint8_t> expected{0, 0, 0, 0, 1, 2, 0, 3, 4};
+  EXPECT_EQ(expected, ReadLevel(0, 3, 3));
+  texture->UnBind();
+}
+
+TEST(TextureTest, UpdateMipmapsInRegion) {
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithStorage(4, 4, 3, Texture::InternalFormat::kR8)
+                     .Build();
+  texture->Bind();
+  const std::vector<std::uint8_t> zeros(16, 0);
+  texture->UpdateRegion(0, 0, 4, 4, zeros.data(), true);
+  EXPECT_EQ(std::vector<std::uint8_t>(4, 0), ReadLevel(1, 2, 2));
+  const std::vector<std::uint8_t> region(4, 200);
+  texture->UpdateRegion(2, 2, 2, 2, region.data(), true);
+  const std::vector<std::uint8_t> expected_level_1{0, 0, 0, 200};
+  EXPECT_EQ(expected_level_1, ReadLevel(1, 2, 2));
+  EXPECT_NEAR(50, ReadLevel(2, 1, 1).front(), 1);
+  texture->UnBind();
+}
+
+TEST(TextureTest, SetImageIntoStorage) {
+  const auto image{
+      utils::Image::CreateFrom("utils/test_images/container.jpg")};
+  ASSERT_TRUE(image.has_value());
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithStorage(image->width(),
+                                  image->height(),
+                                  1,
+                                  Texture::InternalFormat::kRGB8)
+                     .WithImage(image.value())
+                     .Build();
+  texture->Bind();
+  std::vector<std::uint8_t> pixels(image->width() * image->height() * 3);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+  EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), image->data()));
+  texture->UnBind();
+}
+
+TEST(TextureTest, ImageLayers) {
+  std::vector<utils::Image> images;
+  for (std::uint8_t layer = 0; layer < 3; ++layer) {
+    const std::vector<std::uint8_t> data(2 * 2 * 3, layer * 10);
+    images.push_back(utils::Image::CreateFromData(2, 2, 3, data.data()));
+  }
+  auto texture = Texture::Builder{Texture::Type::kTexture2DArray,
+                                  Texture::Identifier::kTexture0}
+                     .WithImageLayers(images)
+                     .Build();
+  EXPECT_EQ(3, texture->number_of_layers());
+  EXPECT_EQ(2, texture->number_of_levels());
+  texture->Bind();
+  std::vector<std::uint8_t> pixels(2 * 2 * 3 * 3);
+  glPixelStorei(GL_PACK_ALIGNMENT, 1);
+  glGetTexImage(
+      GL_TEXTURE_2D_ARRAY, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+  texture->UnBind();
+  for (std::size_t layer = 0; layer < images.size(); ++layer) {
+    EXPECT_EQ(layer * 10, pixels[layer * 12]);
+    EXPECT_EQ(layer * 10, pixels[layer * 12 + 11]);
+  }
+}
+
+TEST(TextureTest, CompressedImage) {
+  ASSERT_TRUE(Texture::IsCompressedFormatSupported(GL_COMPRESSED_RED_RGTC1));
+  // A single BC4 block: both reference values are 200 and all indices are 0.
+  const auto ktx{utils::CreateKtxBytes(GL_COMPRESSED_RED_RGTC1,
+                                       GL_RED,
+                                       4u,
+                                       4u,
+                                       {{200, 200, 0, 0, 0, 0, 0, 0}})};
+  const auto image{utils::CompressedImage::CreateFromKtxBytes(ktx)};
+  ASSERT_TRUE(image.has_value());
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithCompressedImage(image.value())
+                     .Build();
+  EXPECT_EQ(Texture::InternalFormat::kCompressedRedBc4,
+            texture->internal_format());
+  texture->Bind();
+  GLint compressed{};
+  glGetTexLevelParameteriv(
+      GL_TEXTURE_2D, 0, GL_TEXTURE_COMPRESSED, &compressed);
+  EXPECT_EQ(GL_TRUE, compressed);
+  EXPECT_EQ(std::vector<std::uint8_t>(16, 200), ReadLevel(0, 4, 4));
+  texture->UnBind();
+}
+
+TEST(TextureTest, SetImageWithNativeFormat) {
+  // Rows of this image are not aligned to 4 bytes.
+  const std::vector<std::uint8_t> gray{1, 2, 3, 4, 5, 6};
+  const auto gray_image{utils::Image::CreateFromData(3, 2, 1, gray.data())};
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithImage(gray_image)
+                     .Build();
+  EXPECT_EQ(Texture::InternalFormat::kR8, texture->internal_format());
+  texture->Bind();
+  EXPECT_EQ(gray, ReadLevel(0, 3, 2));
+
+  const std::vector<std::uint16_t> depth{1000, 2000, 3000, 60000};
+  texture->SetImage(utils::Image::CreateFromData(
+      2, 2, 1, depth.data(), utils::Image::DataType::kUint16));
+  EXPECT_EQ(Texture::InternalFormat::kR16, texture->internal_format());
+  std::vector<std::uint16_t> depth_pixels(depth.size());
+  glGetTexImage(
+      GL_TEXTURE_2D, 0, GL_RED, GL_UNSIGNED_SHORT, depth_pixels.data());
+  EXPECT_EQ(depth, depth_pixels);
+
+  const std::vector<float> heights{-1.5f, 0.25f, 1000.0f, 3.0f};
+  texture->SetImage(utils::Image::CreateFromData(
+      2, 2, 1, heights.data(), utils::Image::DataType::kFloat));
+  EXPECT_EQ(Texture::InternalFormat::kR32F, texture->internal_format());
+  std::vector<float> height_pixels(heights.size());
+  glGetTexImage(GL_TEXTURE_2D, 0, GL_RED, GL_FLOAT, height_pixels.data());
+  EXPECT_EQ(heights, height_pixels);
+  texture->UnBind();
+}
+
+TEST(TextureTest, SwizzleFollowsFormat) {
+  const auto get_swizzle = []() {
+    std::vector<GLint> swizzle(4);
+    glGetTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle.data());
+    return swizzle;
+  };
+  const std::vector<GLint> gray{GL_RED, GL_RED, GL_RED, GL_ONE};
+  const std::vector<GLint> identity{GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+  const std::vector<std::uint8_t> pixels(4 * 4 * 4, 42);
+  const auto gray_image{utils::Image::CreateFromData(4, 4, 1, pixels.data())};
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithImage(gray_image)
+                     .Build();
+  texture->Bind();
+  EXPECT_EQ(gray, get_swizzle());
+  texture->SetImage(utils::Image::CreateFromData(4, 4, 3, pixels.data()));
+  EXPECT_EQ(identity, get_swizzle());
+  texture->UnBind();
+
+  auto storage = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithStorage(4, 4, 1, Texture::InternalFormat::kR8)
+                     .Build();
+  storage->Bind();
+  EXPECT_EQ(gray, get_swizzle());
+  storage->UnBind();
+}
+
+TEST(TextureTest, SetImagePyramid) {
+  std::vector<utils::Image> levels;
+  for (int level = 0; level < 3; ++level) {
+    const int size{4 >> level};
+    const std::vector<std::uint8_t> data(size * size, 10 * (level + 1));
+    levels.push_back(utils::Image::CreateFromData(size, size, 1, data.data()));
+  }
+  auto texture = Texture::Builder{Texture::Type::kTexture2D,
+                                  Texture::Identifier::kTexture0}
+                     .WithImagePyramid(levels)
+                     .Build();
+  EXPECT_EQ(3, texture->number_of_levels());
+  texture->Bind();
+  // The levels are uploaded as they are and not generated from the level 0.
+  EXPECT_EQ(std::vector<std::uint8_t>(4, 20), ReadLevel(1, 2, 2));
+  EXPECT_EQ(std::vector<std::uint8_t>(1, 30), ReadLevel(2, 1, 1));
+  texture->UnBind();
+}
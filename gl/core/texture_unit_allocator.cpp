@@ -0,0 +1,87 @@
+#include "gl/core/texture_unit_allocator.h"
+
+#include "glog/logging.h"
+
+#include <algorithm>
+
+namespace {
+
+constexpr int kMaxNumberOfUnits{gl::Texture::kNumberOfIdentifiers};
+
+template <typename T>
+bool IsSameObject(const std::weak_ptr<T>& weak, const std::shared_ptr<T>& ptr) {
+  if (weak.expired() || !ptr) { return weak.expired() && !ptr; }
+  return !weak.owner_before(ptr) && !ptr.owner_before(weak);
+}
+
+}  // namespace
+
+namespace gl {
+
+GLint TextureUnitAllocator::Bind(const std::shared_ptr<Texture>& texture,
+                                 const std::shared_ptr<Sampler>& sampler) {
+  CHECK(texture) << "Cannot bind a missing texture.";
+  if (units_.empty()) { InitializeUnits(); }
+  ForgetUnitsBoundElsewhere();
+  auto unit_iter{std::find_if(
+      units_.begin(), units_.end(), [&texture](const Unit& unit) {
+        return IsSameObject(unit.texture, texture);
+      })};
+  if (unit_iter == units_.end()) {
+    // Take the least recently used unit that no texture needs in this frame.
+    for (auto iter = units_.begin(); iter != units_.end(); ++iter) {
+      if (iter->last_used_frame == frame_) { continue; }
+      if (unit_iter == units_.end() || iter->last_use < unit_iter->last_use) {
+        unit_iter = iter;
+      }
+    }
+    CHECK(unit_iter != units_.end())
+        << "More than " << number_of_units_
+        << " textures are used in one frame.";
+    const auto unit{static_cast<GLuint>(unit_iter - units_.begin())};
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(static_cast<GLenum>(texture->type()), texture->id());
+    unit_iter->texture = texture;
+    ++number_of_texture_binds_;
+  }
+  const auto unit{static_cast<GLuint>(unit_iter - units_.begin())};
+  if (!unit_iter->is_sampler_known ||
+      !IsSameObject(unit_iter->sampler, sampler)) {
+    if (sampler) {
+      sampler->Bind(unit);
+    } else {
+      Sampler::UnBind(unit);
+    }
+    unit_iter->sampler = sampler;
+    unit_iter->is_sampler_known = true;
+  }
+  unit_iter->last_used_frame = frame_;
+  unit_iter->last_use = ++use_counter_;
+  return static_cast<GLint>(unit);
+}
+
+void TextureUnitAllocator::Reset() {
+  std::fill(units_.begin(), units_.end(), Unit{});
+}
+
+void TextureUnitAllocator::ForgetUnitsBoundElsewhere() {
+  for (std::size_t index = 0; index < units_.size(); ++index) {
+    const auto binds{Texture::number_of_binds_on_unit(static_cast<int>(index))};
+    if (units_[index].known_binds_on_unit == binds) { continue; }
+    units_[index] = Unit{};
+    units_[index].known_binds_on_unit = binds;
+  }
+}
+
+void TextureUnitAllocator::InitializeUnits() {
+  if (number_of_units_ <= 0) {
+    GLint max_units{};
+    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &max_units);
+    number_of_units_ = max_units;
+  }
+  // Texture::Identifier does not go beyond 32 units.
+  number_of_units_ = std::min(number_of_units_, kMaxNumberOfUnits);
+  units_.resize(number_of_units_);
+}
+
+}  // namespace gl
@@ -0,0 +1,74 @@
+#ifndef OPENGL_TUTORIALS_CORE_TEXTURE_UNIT_ALLOCATOR_H_
+#define OPENGL_TUTORIALS_CORE_TEXTURE_UNIT_ALLOCATOR_H_
+
+#include "gl/core/sampler.h"
+#include "gl/core/texture.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace gl {
+
+/// Picks texture units for textures instead of using a fixed identifier.
+///
+/// The allocator remembers which texture and sampler is bound to each unit.
+/// A texture that is still bound to some unit is not bound again, otherwise
+/// it takes the least recently used unit that is not used in the current
+/// frame. Units that were changed with Texture::Bind or Texture::UnBind since
+/// are forgotten, anything else bound behind the back of the allocator needs a
+/// call to Reset.
+class TextureUnitAllocator {
+ public:
+  /// If the number of units is not given, it is queried from OpenGL when the
+  /// first texture is bound.
+  explicit TextureUnitAllocator(int number_of_units = 0)
+      : number_of_units_{number_of_units} {}
+
+  /// Mark the start of a new frame. Units used in the previous frames can be
+  /// given to other textures from now on.
+  void BeginFrame() noexcept { ++frame_; }
+
+  /// Bind a texture and an optional sampler to some texture unit. Returns the
+  /// index of the unit, which should be set to the sampler uniform.
+  GLint Bind(const std::shared_ptr<Texture>& texture,
+             const std::shared_ptr<Sampler>& sampler = nullptr);
+
+  /// Forget what is bound to the texture units.
+  void Reset();
+
+  int number_of_units() const noexcept { return number_of_units_; }
+
+  /// Number of times a texture was actually bound to a unit.
+  std::size_t number_of_texture_binds() const noexcept {
+    return number_of_texture_binds_;
+  }
+
+ private:
+  struct Unit {
+    /// Weak pointers never match an object that was destroyed in the
+    /// meantime, even if OpenGL reuses its name for a new one.
+    std::weak_ptr<Texture> texture{};
+    std::weak_ptr<Sampler> sampler{};
+    bool is_sampler_known{};
+    std::uint64_t last_used_frame{};
+    std::uint64_t last_use{};
+    /// Texture::number_of_binds_on_unit when the unit was last checked.
+    std::uint64_t known_binds_on_unit{};
+  };
+
+  void InitializeUnits();
+  /// Forget the units that textures were bound to without the allocator.
+  void ForgetUnitsBoundElsewhere();
+
+  int number_of_units_{};
+  std::vector<Unit> units_{};
+  /// The first frame is 1, so that no unit is used in it yet.
+  std::uint64_t frame_{1u};
+  std::uint64_t use_counter_{};
+  std::size_t number_of_texture_binds_{};
+};
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_CORE_TEXTURE_UNIT_ALLOCATOR_H_
@@ -0,0 +1,96 @@
+#include "gl/core/streaming_texture.h"
+#include "gl/core/texture_unit_allocator.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+using gl::Sampler;
+using gl::StreamingTexture;
+using gl::Texture;
+using gl::TextureUnitAllocator;
+
+namespace {
+std::shared_ptr<Texture> CreateTexture() {
+  return Texture::Builder{Texture::Type::kTexture2D,
+                          Texture::Identifier::kTexture0}
+      .Build();
+}
+
+GLint GetBinding(GLint unit, GLenum binding) {
+  GLint id{};
+  glActiveTexture(GL_TEXTURE0 + unit);
+  glGetIntegerv(binding, &id);
+  return id;
+}
+
+GLint GetBoundTexture(GLint unit) {
+  return GetBinding(unit, GL_TEXTURE_BINDING_2D);
+}
+}  // namespace
+
+TEST(TextureUnitAllocatorTest, SkipRebinds) {
+  TextureUnitAllocator allocator{2};
+  const auto texture{CreateTexture()};
+  const auto unit{allocator.Bind(texture)};
+  EXPECT_EQ(static_cast<GLint>(texture->id()), GetBoundTexture(unit));
+  allocator.BeginFrame();
+  EXPECT_EQ(unit, allocator.Bind(texture));
+  EXPECT_EQ(unit, allocator.Bind(texture));
+  EXPECT_EQ(1ul, allocator.number_of_texture_binds());
+}
+
+TEST(TextureUnitAllocatorTest, ReplaceLeastRecentlyUsed) {
+  TextureUnitAllocator allocator{2};
+  const auto first{CreateTexture()};
+  const auto second{CreateTexture()};
+  const auto third{CreateTexture()};
+  const auto first_unit{allocator.Bind(first)};
+  const auto second_unit{allocator.Bind(second)};
+  EXPECT_NE(first_unit, second_unit);
+  allocator.BeginFrame();
+  allocator.Bind(first);
+  // The second texture was used least recently, so its unit is reused.
+  EXPECT_EQ(second_unit, allocator.Bind(third));
+  EXPECT_EQ(static_cast<GLint>(third->id()), GetBoundTexture(second_unit));
+  EXPECT_EQ(static_cast<GLint>(first->id()), GetBoundTexture(first_unit));
+  EXPECT_EQ(3ul, allocator.number_of_texture_binds());
+}
+
+TEST(TextureUnitAllocatorTest, BindSampler) {
+  TextureUnitAllocator allocator{1};
+  const auto texture{CreateTexture()};
+  const auto sampler{std::make_shared<Sampler>(Sampler::Parameters{})};
+  const auto unit{allocator.Bind(texture, sampler)};
+  EXPECT_EQ(static_cast<GLint>(sampler->id()),
+            GetBinding(unit, GL_SAMPLER_BINDING));
+  allocator.BeginFrame();
+  allocator.Bind(texture);
+  EXPECT_EQ(0, GetBinding(unit, GL_SAMPLER_BINDING));
+}
+
+TEST(TextureUnitAllocatorTest, DestroyedTextureIsBoundAgain) {
+  TextureUnitAllocator allocator{1};
+  allocator.Bind(CreateTexture());
+  allocator.BeginFrame();
+  // The new texture may get the name of the destroyed one.
+  const auto texture{CreateTexture()};
+  const auto unit{allocator.Bind(texture)};
+  EXPECT_EQ(static_cast<GLint>(texture->id()), GetBoundTexture(unit));
+  EXPECT_EQ(2ul, allocator.number_of_texture_binds());
+}
+
+TEST(TextureUnitAllocatorTest, BindAgainAfterStreamingUpdate) {
+  TextureUnitAllocator allocator{1};
+  StreamingTexture streaming_texture{Texture::Identifier::kTexture0, 2, 2, 3};
+  const auto& texture{streaming_texture.texture()};
+  const auto unit{allocator.Bind(texture)};
+  EXPECT_EQ(static_cast<GLint>(texture->id()), GetBoundTexture(unit));
+  allocator.BeginFrame();
+  // The update binds and unbinds the texture without the allocator.
+  const std::vector<std::uint8_t> frame(2 * 2 * 3, 42);
+  streaming_texture.Update(frame.data());
+  EXPECT_EQ(unit, allocator.Bind(texture));
+  EXPECT_EQ(static_cast<GLint>(texture->id()), GetBoundTexture(unit));
+  EXPECT_EQ(2ul, allocator.number_of_texture_binds());
+}
@@ -3,24 +3,37 @@
 
 /// Generate a specialization that calls an appropriate version of glUniform
 /// based on the number of parameters and their type.
-#define GENERATE_FOR_PACKS(type, letter, num_of_params, ...)             \
-  template <>                                                            \
-  void Uniform::UpdateValueFromPack(std::int32_t location,               \
-                                    PREFIX_EACH_OF(type, __VA_ARGS__)) { \
-    glUniform##num_of_params##letter(location, __VA_ARGS__);             \
+#define GENERATE_FOR_PACKS(type, letter, num_of_params, ...)                   \
+  template <>                                                                  \
+  void Uniform::UpdateValueFromPack(std::int32_t location,                     \
+                                    PREFIX_EACH_OF(type, __VA_ARGS__)) {       \
+    if (program_targeted_) {                                                   \
+      glProgramUniform##num_of_params##letter(                                 \
+          program_id_, location, __VA_ARGS__);                                 \
+      return;                                                                  \
+    }                                                                          \
+    glUniform##num_of_params##letter(location, __VA_ARGS__);                   \
   }
 
 /// Generate a specialization that calls an appropriate vector-based version of
 /// glUniform based on the type of the input parameters.
-#define GENERATE_FOR_ARRAYS(type, letter, num_of_params)              \
-                                                                      \
-  template <>                                                         \
-  void Uniform::UpdateValueFromArray<num_of_params##ul, type>(        \
-      std::int32_t location,                                          \
-      const void* const data,                                         \
-      std::size_t number_of_vectors) {                                \
-    glUniform##num_of_params##letter##v(                              \
-        location, number_of_vectors, static_cast<const type*>(data)); \
+#define GENERATE_FOR_ARRAYS(type, letter, num_of_params)                       \
+                                                                               \
+  template <>                                                                  \
+  void Uniform::UpdateValueFromArray<num_of_params##ul, type>(                 \
+      std::int32_t location,                                                   \
+      const void* const data,                                                  \
+      std::size_t number_of_vectors) {                                         \
+    if (program_targeted_) {                                                   \
+      glProgramUniform##num_of_params##letter##v(                              \
+          program_id_,                                                         \
+          location,                                                            \
+          number_of_vectors,                                                   \
+          static_cast<const type*>(data));                                     \
+      return;                                                                  \
+    }                                                                          \
+    glUniform##num_of_params##letter##v(                                       \
+        location, number_of_vectors, static_cast<const type*>(data));          \
   }
 
 /// Generate a specialization that calls an appropriate matrix-based version of
@@ -33,6 +46,15 @@
       const void* const data,                                                  \
       std::size_t number_of_vectors,                                           \
       bool transpose) {                                                        \
+    if (program_targeted_) {                                                   \
+      glProgramUniformMatrix##rows##x##cols##letter##v(                        \
+          program_id_,                                                         \
+          location,                                                            \
+          number_of_vectors,                                                   \
+          transpose,                                                           \
+          static_cast<const type*>(data));                                     \
+      return;                                                                  \
+    }                                                                          \
     glUniformMatrix##rows##x##cols##letter##v(location,                        \
                                               number_of_vectors,               \
                                               transpose,                       \
@@ -41,18 +63,27 @@
 
 /// Generate a specialization that calls an appropriate matrix-based version of
 /// glUniform based on the type of the input parameters.
-#define GENERATE_FOR_SQUARE_MATRICES(type, letter, size)              \
-                                                                      \
-  template <>                                                         \
-  void Uniform::UpdateValueFromMatrix<size##ul, size##ul, type>(      \
-      std::int32_t location,                                          \
-      const void* const data,                                         \
-      std::size_t number_of_vectors,                                  \
-      bool transpose) {                                               \
-    glUniformMatrix##size##letter##v(location,                        \
-                                     number_of_vectors,               \
-                                     transpose,                       \
-                                     static_cast<const type*>(data)); \
+#define GENERATE_FOR_SQUARE_MATRICES(type, letter, size)                       \
+                                                                               \
+  template <>                                                                  \
+  void Uniform::UpdateValueFromMatrix<size##ul, size##ul, type>(               \
+      std::int32_t location,                                                   \
+      const void* const data,                                                  \
+      std::size_t number_of_vectors,                                           \
+      bool transpose) {                                                        \
+    if (program_targeted_) {                                                   \
+      glProgramUniformMatrix##size##letter##v(                                 \
+          program_id_,                                                         \
+          location,                                                            \
+          number_of_vectors,                                                   \
+          transpose,                                                           \
+          static_cast<const type*>(data));                                     \
+      return;                                                                  \
+    }                                                                          \
+    glUniformMatrix##size##letter##v(location,                                 \
+                                     number_of_vectors,                        \
+                                     transpose,                                \
+                                     static_cast<const type*>(data));          \
   }
 
 #define GENERATE_PACK_SPECIALIZATIONS(type, letter) \
@@ -81,6 +112,35 @@
 
 namespace gl {
 
+bool Uniform::StageBytes(const void* const data,
+                         std::size_t number_of_bytes,
+                         std::size_t number_of_elements,
+                         CommitFunction commit_function) {
+  const auto* const bytes{static_cast<const std::uint8_t*>(data)};
+  staged_value_.assign(bytes, bytes + number_of_bytes);
+  staged_number_of_elements_ = number_of_elements;
+  staged_commit_function_ = commit_function;
+  const bool was_pending{has_pending_value_};
+  has_pending_value_ =
+      !has_committed_value_ ||
+      committed_commit_function_ != staged_commit_function_ ||
+      committed_number_of_elements_ != staged_number_of_elements_ ||
+      committed_value_ != staged_value_;
+  return !was_pending && has_pending_value_;
+}
+
+void Uniform::Commit() {
+  if (!has_pending_value_) { return; }
+  staged_commit_function_(
+      *this, staged_value_.data(), staged_number_of_elements_);
+  // Swap to keep the allocated memory of both buffers around.
+  std::swap(committed_value_, staged_value_);
+  committed_number_of_elements_ = staged_number_of_elements_;
+  committed_commit_function_ = staged_commit_function_;
+  has_committed_value_ = true;
+  has_pending_value_ = false;
+}
+
 GENERATE_PACK_SPECIALIZATIONS(float, f);
 GENERATE_ARRAY_SPECIALIZATIONS(float, f);
 GENERATE_MATRIX_SPECIALIZATIONS(float, f);
@@ -5,9 +5,13 @@
 #include "gl/core/traits.h"
 #include "utils/type_traits.h"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
 #include <exception>
 #include <iostream>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace gl {
@@ -17,10 +21,26 @@ class Uniform : public OpenGlObject {
   Uniform(const std::string& name, std::uint32_t program_id)
       : OpenGlObject{0},
         name_{name},
-        location_{glGetUniformLocation(program_id, name_.c_str())} {}
+        location_{glGetUniformLocation(program_id, name_.c_str())},
+        program_id_{program_id},
+        program_targeted_{program_id > 0 &&
+                          ProgramTargetedUpdatesSupported()} {}
 
   GLint location() const noexcept { return location_; }
 
+  /// Id of the program this uniform belongs to.
+  std::uint32_t program_id() const noexcept { return program_id_; }
+
+  /// If true, the value is written directly into the program this uniform
+  /// belongs to with glProgramUniform*, so the program does not need to be
+  /// active. Otherwise, the value goes to the currently active program.
+  bool program_targeted() const noexcept { return program_targeted_; }
+
+  /// Updating uniforms of a program that is not in use needs OpenGL 4.1.
+  static bool ProgramTargetedUpdatesSupported() noexcept {
+    return GLAD_GL_VERSION_4_1;
+  }
+
   template <typename T, typename A>
   void UpdateValue(const std::vector<T, A>& data) {
     UpdateValue(data.data(), data.size());
@@ -28,6 +48,7 @@ class Uniform : public OpenGlObject {
 
   template <typename T>
   void UpdateValue(const T* const data, std::size_t number_of_elements) {
+    ForgetCachedValues();
     UpdateArrayLike<T>(static_cast<const void*>(data), number_of_elements);
   }
 
@@ -35,8 +56,12 @@ class Uniform : public OpenGlObject {
             typename = std::enable_if_t<traits::is_matrix_v<T> ||
                                         traits::is_vector_v<T>>>
   void UpdateValue(const T& matrix_or_vector) {
-    UpdateArrayLike<std::remove_reference_t<T>>(
-        static_cast<const void*>(&matrix_or_vector), 1ul);
+    ForgetCachedValues();
+    // Expressions like Eigen::Matrix4f::Identity() do not hold their values,
+    // so evaluate them first.
+    using PlainObject = typename T::PlainObject;
+    const PlainObject value{matrix_or_vector};
+    UpdateArrayLike<PlainObject>(static_cast<const void*>(&value), 1ul);
   }
 
   template <typename T,
@@ -46,12 +71,94 @@ class Uniform : public OpenGlObject {
                 (::traits::all_types_integral_v<T, Ts...> ||
                  ::traits::all_types_floating_point_v<T, Ts...>)>>
   void UpdateValue(T number, Ts... numbers) {
+    ForgetCachedValues();
     UpdateValueFromPack(location_, number, numbers...);
   }
 
+  /// The StageValue functions remember a value without sending it to OpenGL.
+  /// Only the last staged value is sent on the next call to Commit and only if
+  /// it differs from the value that was committed before.
+  ///
+  /// Return true if this uniform was not waiting for a commit before the call
+  /// and is waiting for it now.
+  template <typename T, typename A>
+  bool StageValue(const std::vector<T, A>& data) {
+    return StageValue(data.data(), data.size());
+  }
+
+  template <typename T>
+  bool StageValue(const T* const data, std::size_t number_of_elements) {
+    return StageBytes(data,
+                      sizeof(T) * number_of_elements,
+                      number_of_elements,
+                      &CommitArrayLike<T>);
+  }
+
+  template <typename T,
+            typename = std::enable_if_t<traits::is_matrix_v<T> ||
+                                        traits::is_vector_v<T>>>
+  bool StageValue(const T& matrix_or_vector) {
+    // Stage the values rather than the bytes of a possible expression.
+    using PlainObject = typename T::PlainObject;
+    const PlainObject value{matrix_or_vector};
+    return StageBytes(
+        &value, sizeof(PlainObject), 1ul, &CommitArrayLike<PlainObject>);
+  }
+
+  template <typename T,
+            typename... Ts,
+            typename = std::enable_if_t<
+                ::traits::all_types_are_same_v<T, Ts...> &&
+                (::traits::all_types_integral_v<T, Ts...> ||
+                 ::traits::all_types_floating_point_v<T, Ts...>)>>
+  bool StageValue(T number, Ts... numbers) {
+    constexpr std::size_t kCount{1ul + sizeof...(Ts)};
+    const std::array<T, kCount> values{number, numbers...};
+    return StageBytes(&values, sizeof(values), 1ul, &CommitPack<T, kCount>);
+  }
+
+  /// Send the staged value to OpenGL if it differs from the committed one.
+  void Commit();
+
+  inline bool has_pending_value() const noexcept { return has_pending_value_; }
+
   inline const std::string& name() const { return name_; }
 
  private:
+  using CommitFunction = void (*)(Uniform& uniform,
+                                  const void* const data,
+                                  std::size_t number_of_elements);
+
+  template <typename T>
+  static void CommitArrayLike(Uniform& uniform,
+                              const void* const data,
+                              std::size_t number_of_elements) {
+    uniform.UpdateArrayLike<T>(data, number_of_elements);
+  }
+
+  template <typename T, std::size_t kCount>
+  static void CommitPack(Uniform& uniform,
+                         const void* const data,
+                         std::size_t /* number_of_elements */) {
+    std::array<T, kCount> values{};
+    std::memcpy(values.data(), data, sizeof(values));
+    std::apply(
+        [&uniform](auto... numbers) {
+          uniform.UpdateValueFromPack(uniform.location_, numbers...);
+        },
+        values);
+  }
+
+  bool StageBytes(const void* const data,
+                  std::size_t number_of_bytes,
+                  std::size_t number_of_elements,
+                  CommitFunction commit_function);
+
+  inline void ForgetCachedValues() noexcept {
+    has_pending_value_ = false;
+    has_committed_value_ = false;
+  }
+
   template <typename T>
   static constexpr int GetRowsOfType() {
     static_assert(
@@ -106,6 +213,18 @@ class Uniform : public OpenGlObject {
 
   std::string name_;
   std::int32_t location_;
+  std::uint32_t program_id_;
+  bool program_targeted_;
+
+  std::vector<std::uint8_t> staged_value_{};
+  std::size_t staged_number_of_elements_{};
+  CommitFunction staged_commit_function_{nullptr};
+  bool has_pending_value_{};
+
+  std::vector<std::uint8_t> committed_value_{};
+  std::size_t committed_number_of_elements_{};
+  CommitFunction committed_commit_function_{nullptr};
+  bool has_committed_value_{};
 };
 
 }  // namespace gl
@@ -48,6 +48,60 @@ TEST_F(UniformTest, UpdateValueFromPack) {
   uniform_4.UpdateValue(1.0f, 2.0f, 3.0f, 4.0f);
 }
 
+TEST_F(UniformTest, UpdateValueWithoutActiveProgram) {
+  ASSERT_TRUE(Uniform::ProgramTargetedUpdatesSupported());
+  Uniform uniform{"dummy_value_dim_2", program_->id()};
+  EXPECT_TRUE(uniform.program_targeted());
+  EXPECT_EQ(uniform.program_id(), program_->id());
+  glUseProgram(0);
+  uniform.UpdateValue(1.0f, 2.0f);
+  GLfloat values[2]{};
+  glGetUniformfv(program_->id(), uniform.location(), values);
+  EXPECT_FLOAT_EQ(values[0], 1.0f);
+  EXPECT_FLOAT_EQ(values[1], 2.0f);
+  GLint active_program{};
+  glGetIntegerv(GL_CURRENT_PROGRAM, &active_program);
+  EXPECT_EQ(active_program, 0);
+}
+
+TEST_F(UniformTest, StageAndCommit) {
+  Uniform uniform{"dummy_value_dim_2", program_->id()};
+  uniform.UpdateValue(0.0f, 0.0f);
+  EXPECT_TRUE(uniform.StageValue(1.0f, 2.0f));
+  EXPECT_FALSE(uniform.StageValue(3.0f, 4.0f));
+  EXPECT_TRUE(uniform.has_pending_value());
+  GLfloat values[2]{};
+  glGetUniformfv(program_->id(), uniform.location(), values);
+  EXPECT_FLOAT_EQ(values[0], 0.0f);
+  uniform.Commit();
+  EXPECT_FALSE(uniform.has_pending_value());
+  glGetUniformfv(program_->id(), uniform.location(), values);
+  EXPECT_FLOAT_EQ(values[0], 3.0f);
+  EXPECT_FLOAT_EQ(values[1], 4.0f);
+  // Staging the value that is already committed does not need a commit.
+  EXPECT_FALSE(uniform.StageValue(3.0f, 4.0f));
+  EXPECT_FALSE(uniform.has_pending_value());
+  EXPECT_TRUE(uniform.StageValue(Eigen::Vector2f{5.0f, 6.0f}));
+  uniform.Commit();
+  glGetUniformfv(program_->id(), uniform.location(), values);
+  EXPECT_FLOAT_EQ(values[0], 5.0f);
+  EXPECT_FLOAT_EQ(values[1], 6.0f);
+}
+
+TEST_F(UniformTest, StageMatrixExpression) {
+  Uniform uniform{"matrix_3", program_->id()};
+  uniform.UpdateValue(Eigen::Matrix3f::Zero());
+  GLfloat values[9]{};
+  glGetUniformfv(program_->id(), uniform.location(), values);
+  EXPECT_FLOAT_EQ(values[0], 0.0f);
+  EXPECT_TRUE(uniform.StageValue(Eigen::Matrix3f::Identity()));
+  uniform.Commit();
+  glGetUniformfv(program_->id(), uniform.location(), values);
+  for (int i = 0; i < 9; ++i) {
+    EXPECT_FLOAT_EQ(values[i], i % 4 == 0 ? 1.0f : 0.0f) << "Entry " << i;
+  }
+}
+
 TEST_F(UniformTest, UpdateValueFromEigenMat) {
   Uniform uniform_2{"dummy_value_dim_2", program_->id()};
   EXPECT_EQ(uniform_2.location(), 1);
@@ -9,6 +9,7 @@
 #include <array>
 #include <iostream>
 #include <memory>
+#include <optional>
 
 namespace gl {
 
@@ -82,13 +83,38 @@ class VertexArrayBuffer : public OpenGlObject {
     return true;
   }
 
+  /// Advance the attribute once per this many instances instead of once per
+  /// vertex. A divisor of zero makes it a per-vertex attribute again.
+  void SetVertexAttributeDivisor(int layout_index, GLuint divisor) {
+    Bind();
+    glVertexAttribDivisor(layout_index, divisor);
+    UnBind();
+  }
+
+  /// Draw all the vertices this many times with a single draw call. Without
+  /// a number of instances, the vertices are drawn once without instancing.
+  void SetNumberOfInstances(std::optional<GLsizei> number_of_instances) {
+    number_of_instances_ = number_of_instances;
+  }
+
   void Bind() { glBindVertexArray(id_); }
   void UnBind() { glBindVertexArray(0u); }
 
   bool Draw(GLint gl_primitive_mode, int stride = 1) {
     CHECK(!bound_buffers_.empty()) << "There are no buffers to draw.";
     Bind();
-    if (indices_present_) {
+    if (number_of_instances_ && indices_present_) {
+      glDrawElementsInstanced(gl_primitive_mode,
+                              number_of_elements_to_draw_,
+                              gl_indices_type_,
+                              0,
+                              number_of_instances_.value());
+    } else if (number_of_instances_) {
+      glDrawArraysInstanced(gl_primitive_mode,
+                            0,
+                            number_of_elements_to_draw_ / stride,
+                            number_of_instances_.value());
+    } else if (indices_present_) {
       glDrawElements(
           gl_primitive_mode, number_of_elements_to_draw_, gl_indices_type_, 0);
     } else {
@@ -113,6 +139,7 @@ class VertexArrayBuffer : public OpenGlObject {
   bool indices_present_{false};
   GLint gl_indices_type_{};
   GLint number_of_elements_to_draw_{};
+  std::optional<GLsizei> number_of_instances_{};
 
   std::map<Buffer::Type,
            std::map<OpenGlObject::IdType, std::shared_ptr<Buffer>>>
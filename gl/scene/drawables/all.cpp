@@ -5,10 +5,21 @@
 #include "gl/scene/drawables/all.h"
 
 #include "gl/scene/program_pool.h"
+#include "gl/scene/text_layout.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
+namespace {
+
+/// Every glyph instance of a text holds the anchor and the color of its
+/// label, the corners of the glyph quad and its texture coordinates.
+constexpr std::size_t kFloatsPerGlyph{14ul};
+
+}  // namespace
+
 namespace gl {
 
 Points::Points(ProgramPool* program_pool,
@@ -52,13 +63,13 @@ void Points::FillBuffers() {
       std::make_shared<gl::Buffer>(gl::Buffer::Type::kArrayBuffer,
                                    gl::Buffer::Usage::kStaticDraw,
                                    intensities_));
-  program_pool_->UseProgram(program_index_.value());
+  const auto program_index{program_index_.value()};
   color_uniform_index_ =
-      program_pool_->SetUniformToActiveProgram("color", color_);
-  model_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "model", Eigen::Matrix4f::Identity());
-  projection_view_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "proj_view", Eigen::Matrix4f::Identity());
+      program_pool_->SetUniform(program_index, "color", color_);
+  model_uniform_index_ = program_pool_->SetUniform(
+      program_index, "model", Eigen::Matrix4f::Identity());
+  projection_view_uniform_index_ = program_pool_->SetUniform(
+      program_index, "proj_view", Eigen::Matrix4f::Identity());
   ready_to_draw_ = true;
 }
 
@@ -85,19 +96,22 @@ void CoordinateSystem::FillBuffers() {
       std::make_shared<gl::Buffer>(gl::Buffer::Type::kArrayBuffer,
                                    gl::Buffer::Usage::kStaticDraw,
                                    points));
-  program_pool_->UseProgram(program_index_.value());
-  model_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "model", Eigen::Matrix4f::Identity());
-  projection_view_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "proj_view", Eigen::Matrix4f::Identity());
+  const auto program_index{program_index_.value()};
+  model_uniform_index_ = program_pool_->SetUniform(
+      program_index, "model", Eigen::Matrix4f::Identity());
+  projection_view_uniform_index_ = program_pool_->SetUniform(
+      program_index, "proj_view", Eigen::Matrix4f::Identity());
   ready_to_draw_ = true;
 }
 
 RectWithTexture::RectWithTexture(ProgramPool* program_pool,
                                  ProgramPool::ProgramIndex program_index,
                                  std::shared_ptr<gl::Texture> texture,
-                                 const Eigen::Vector2f& size)
-    : Drawable{program_pool, program_index, GL_POINTS}, size_{size} {
+                                 const Eigen::Vector2f& size,
+                                 const Eigen::Vector4f& uv_rect)
+    : Drawable{program_pool, program_index, GL_POINTS},
+      size_{size},
+      uv_rect_{uv_rect} {
   texture_ = texture;
 }
 
@@ -112,13 +126,15 @@ void RectWithTexture::FillBuffers() {
       std::make_shared<gl::Buffer>(
           gl::Buffer::Type::kArrayBuffer, gl::Buffer::Usage::kStaticDraw, raw));
 
-  program_pool_->UseProgram(program_index_.value());
-  (void)program_pool_->SetUniformToActiveProgram("source", 0);
-  (void)program_pool_->SetUniformToActiveProgram("rect_size", size_);
-  model_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "model", Eigen::Matrix4f::Identity());
-  projection_view_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "proj_view", Eigen::Matrix4f::Identity());
+  const auto program_index{program_index_.value()};
+  texture_uniform_index_ =
+      program_pool_->SetUniform(program_index, "source", 0);
+  (void)program_pool_->SetUniform(program_index, "rect_size", size_);
+  (void)program_pool_->SetUniform(program_index, "uv_rect", uv_rect_);
+  model_uniform_index_ = program_pool_->SetUniform(
+      program_index, "model", Eigen::Matrix4f::Identity());
+  projection_view_uniform_index_ = program_pool_->SetUniform(
+      program_index, "proj_view", Eigen::Matrix4f::Identity());
   ready_to_draw_ = true;
 }
 
@@ -126,8 +142,11 @@ ScreenRectWithTexture::ScreenRectWithTexture(
     ProgramPool* program_pool,
     ProgramPool::ProgramIndex program_index,
     std::shared_ptr<gl::Texture> texture,
-    const Eigen::Vector2f& size)
-    : Drawable{program_pool, program_index, GL_POINTS}, size_{size} {
+    const Eigen::Vector2f& size,
+    const Eigen::Vector4f& uv_rect)
+    : Drawable{program_pool, program_index, GL_POINTS},
+      size_{size},
+      uv_rect_{uv_rect} {
   texture_ = texture;
 }
 
@@ -142,100 +161,208 @@ void ScreenRectWithTexture::FillBuffers() {
       std::make_shared<gl::Buffer>(
           gl::Buffer::Type::kArrayBuffer, gl::Buffer::Usage::kStaticDraw, raw));
 
-  program_pool_->UseProgram(program_index_.value());
-  (void)program_pool_->SetUniformToActiveProgram("source", 0);
-  (void)program_pool_->SetUniformToActiveProgram("rect_size", size_);
-  model_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "model", Eigen::Matrix4f::Identity());
-  projection_view_uniform_index_ = program_pool_->SetUniformToActiveProgram(
-      "proj_view", Eigen::Matrix4f::Identity());
+  const auto program_index{program_index_.value()};
+  texture_uniform_index_ =
+      program_pool_->SetUniform(program_index, "source", 0);
+  (void)program_pool_->SetUniform(program_index, "rect_size", size_);
+  (void)program_pool_->SetUniform(program_index, "uv_rect", uv_rect_);
+  model_uniform_index_ = program_pool_->SetUniform(
+      program_index, "model", Eigen::Matrix4f::Identity());
+  projection_view_uniform_index_ = program_pool_->SetUniform(
+      program_index, "proj_view", Eigen::Matrix4f::Identity());
+  ready_to_draw_ = true;
+}
+
+TextBatch::TextBatch(ProgramPool* program_pool,
+                     ProgramPool::ProgramIndex program_index,
+                     Font::SharedPtr font,
+                     float height,
+                     const Eigen::Vector3f& color)
+    : Drawable{program_pool, program_index, GL_TRIANGLES, 1.0f, color},
+      font_{std::move(font)},
+      height_{height} {
+  CHECK(font_) << "Text needs a font.";
+  blending_ = true;
+}
+
+std::size_t TextBatch::AddLabel(const std::string& text,
+                                const Eigen::Vector3f& anchor,
+                                std::size_t glyph_capacity,
+                                const Eigen::Vector3f& color) {
+  labels_.push_back({text, anchor, glyph_capacity, color});
+  ready_to_draw_ = false;
+  return labels_.size() - 1ul;
+}
+
+void TextBatch::SetLabelText(std::size_t label_index, const std::string& text) {
+  CHECK_LT(label_index, labels_.size()) << "There is no such label.";
+  auto& label{labels_[label_index]};
+  if (label.text == text) { return; }
+  label.text = text;
+  // The new text will be laid out when the buffers are filled.
+  if (!ready_to_draw_ || !instance_buffer_) { return; }
+  const auto layout{LayoutText(label.text)};
+  if (layout->number_of_glyphs() > label.glyph_capacity) {
+    ready_to_draw_ = false;
+    return;
+  }
+  // Only the glyphs of the old or the new text need to be written.
+  const auto glyphs_to_write{
+      std::max(label.number_of_glyphs, layout->number_of_glyphs())};
+  number_of_glyphs_ -= label.number_of_glyphs;
+  label.number_of_glyphs = layout->number_of_glyphs();
+  number_of_glyphs_ += label.number_of_glyphs;
+  label.layout = layout;
+  UpdateLabelInstances(label, glyphs_to_write);
+}
+
+void TextBatch::SetLabelColor(std::size_t label_index,
+                              const Eigen::Vector3f& color) {
+  CHECK_LT(label_index, labels_.size()) << "There is no such label.";
+  auto& label{labels_[label_index]};
+  label.color = color;
+  if (!ready_to_draw_ || !instance_buffer_) { return; }
+  UpdateLabelInstances(label, label.number_of_glyphs);
+}
+
+void TextBatch::SetLabelsVisible(const std::vector<bool>& visible) {
+  CHECK_EQ(visible.size(), labels_.size()) << "Need a flag for every label.";
+  const bool update_in_place{ready_to_draw_ && instance_buffer_};
+  for (std::size_t i = 0; i < labels_.size(); ++i) {
+    auto& label{labels_[i]};
+    if (label.visible == visible[i]) { continue; }
+    label.visible = visible[i];
+    if (update_in_place) {
+      UpdateLabelInstances(label, label.number_of_glyphs);
+    }
+  }
+}
+
+Eigen::AlignedBox2f TextBatch::ComputeLabelExtent(std::size_t label_index) {
+  const auto layout{LayoutText(labels_.at(label_index).text)};
+  Eigen::AlignedBox2f extent{};
+  for (const auto& glyph : layout->glyphs) {
+    extent.extend(Eigen::Vector2f{glyph.min_x, glyph.min_y});
+    extent.extend(Eigen::Vector2f{glyph.max_x, glyph.max_y});
+  }
+  return extent;
+}
+
+void TextBatch::ClearLabels() {
+  labels_.clear();
+  ready_to_draw_ = false;
+}
+
+std::shared_ptr<const TextLayout> TextBatch::LayoutText(
+    const std::string& text) {
+  if (layout_cache_) { return layout_cache_->Get(*font_, text, height_); }
+  return std::make_shared<const TextLayout>(
+      TextLayout::Create(*font_, text, height_));
+}
+
+void TextBatch::WriteLabelInstances(const Label& label, float* instances) {
+  const auto end{instances + label.glyph_capacity * kFloatsPerGlyph};
+  if (!label.visible) {
+    std::fill(instances, end, 0.0f);
+    return;
+  }
+  for (const auto& glyph : label.layout->glyphs) {
+    for (const float value : {label.anchor.x(),
+                              label.anchor.y(),
+                              label.anchor.z(),
+                              label.color.x(),
+                              label.color.y(),
+                              label.color.z(),
+                              glyph.min_x,
+                              glyph.min_y,
+                              glyph.max_x,
+                              glyph.max_y,
+                              glyph.min_u,
+                              glyph.min_v,
+                              glyph.max_u,
+                              glyph.max_v}) {
+      *instances++ = value;
+    }
+  }
+  std::fill(instances, end, 0.0f);
+}
+
+void TextBatch::UpdateLabelInstances(const Label& label,
+                                     std::size_t number_of_glyphs) {
+  label_instances_.resize(label.glyph_capacity * kFloatsPerGlyph);
+  WriteLabelInstances(label, label_instances_.data());
+  instance_buffer_->UpdateData(label.first_glyph * kFloatsPerGlyph,
+                               label_instances_.data(),
+                               number_of_glyphs * kFloatsPerGlyph);
+}
+
+void TextBatch::FillBuffers() {
+  CHECK(program_pool_) << "Cannot fill buffers without a program pool.";
+  CHECK(program_index_) << "Cannot fill buffers without an active program.";
+
+  std::size_t number_of_slots{};
+  number_of_glyphs_ = 0ul;
+  bool has_spare_slots{false};
+  for (auto& label : labels_) {
+    label.layout = LayoutText(label.text);
+    label.number_of_glyphs = label.layout->number_of_glyphs();
+    label.glyph_capacity =
+        std::max(label.glyph_capacity, label.number_of_glyphs);
+    label.first_glyph = number_of_slots;
+    number_of_slots += label.glyph_capacity;
+    number_of_glyphs_ += label.number_of_glyphs;
+    has_spare_slots |= label.glyph_capacity > label.number_of_glyphs;
+  }
+  std::vector<float> instances(number_of_slots * kFloatsPerGlyph);
+  for (const auto& label : labels_) {
+    WriteLabelInstances(label,
+                        instances.data() + label.first_glyph * kFloatsPerGlyph);
+  }
+
+  texture_ = font_->GetGlTexture();
+  instance_buffer_ = std::make_shared<gl::Buffer>(
+      gl::Buffer::Type::kArrayBuffer,
+      has_spare_slots ? gl::Buffer::Usage::kDynamicDraw
+                      : gl::Buffer::Usage::kStaticDraw,
+      instances);
+  vao_ = std::make_unique<VertexArrayBuffer>();
+  // Two triangles of a quad, its corners are computed from their indices.
+  vao_->AssignBuffer(std::make_shared<gl::Buffer>(
+      gl::Buffer::Type::kElementArrayBuffer,
+      gl::Buffer::Usage::kStaticDraw,
+      std::vector<std::uint32_t>{0u, 1u, 2u, 2u, 1u, 3u}));
+  vao_->AssignBuffer(instance_buffer_);
+  vao_->EnableVertexAttributePointer(0, kFloatsPerGlyph, 0, 3);
+  vao_->EnableVertexAttributePointer(1, kFloatsPerGlyph, 3, 3);
+  vao_->EnableVertexAttributePointer(2, kFloatsPerGlyph, 6, 4);
+  vao_->EnableVertexAttributePointer(3, kFloatsPerGlyph, 10, 4);
+  for (const int layout_index : {0, 1, 2, 3}) {
+    vao_->SetVertexAttributeDivisor(layout_index, 1u);
+  }
+  vao_->SetNumberOfInstances(static_cast<GLsizei>(number_of_slots));
+
+  const auto program_index{program_index_.value()};
+  texture_uniform_index_ =
+      program_pool_->SetUniform(program_index, "source", 0);
+  color_uniform_index_ =
+      program_pool_->SetUniform(program_index, "color", color_);
+  model_uniform_index_ = program_pool_->SetUniform(
+      program_index, "model", Eigen::Matrix4f::Identity());
+  projection_view_uniform_index_ = program_pool_->SetUniform(
+      program_index, "proj_view", Eigen::Matrix4f::Identity());
   ready_to_draw_ = true;
 }
 
-// Text::Text(const std::string& text,
-//            const std::string& font_name,
-//            const Eigen::Vector3f& pos,
-//            float scale,
-//            Style draw_style)
-//     : Drawable{draw_style, GL_TRIANGLES},
-//       text_{text},
-//       font_name_{font_name},
-//       pos_{pos},
-//       scale_{scale} {}
-
-// Text::Text(const std::string& text,
-//            const std::string& font_name,
-//            const Eigen::Vector3f& pos,
-//            float scale)
-//     : Text(text, font_name, pos, scale, Style::DRAW_3D) {}
-// Text::Text(const std::string& text,
-//            const std::string& font_name,
-//            const glow::vec2& pos,
-//            float scale)
-//     : Text(text, font_name, {pos.x, pos.y, -1.0f}, scale, Style::DRAW_2D) {}
-
-// void Text::FillBuffers() {
-//   CHECK(FontPool::Instance().HasFont(font_name_));
-//   auto font = FontPool::Instance().Get(font_name_);
-//   const cv::Mat& texture = font->texture();
-
-//   program_ = ProgramPool::Get(ProgramPool::ProgramType::DRAW_TEXT);
-
-//   texture_ = make_unique<glow::GlTexture>(
-//       texture.cols, texture.rows, glow::TextureFormat::RGBA);
-//   texture_->assign(PixelFormat::BGRA, PixelType::UNSIGNED_BYTE,
-//   texture.data);
-
-//   std::vector<vec2> rect_coords;
-//   rect_coords.reserve(text_.size());
-//   std::vector<vec2> texture_coords;
-//   texture_coords.reserve(text_.size());
-//   float x_start = 0.0f;
-//   float y_start = 0.0f;
-//   float char_height = 0.0f;
-//   for (char c : text_) {
-//     if (c == '\n') {
-//       x_start = 0.0f;
-//       y_start += scale_ * char_height;
-//       continue;
-//     }
-//     if (c == '\t') { c = ' '; }
-//     const auto& texture_pos = font->GetCharCoords(c);
-//     const float x = texture_pos.x;
-//     const float y = texture_pos.y;
-//     const float w = texture_pos.width;
-//     const float h = texture_pos.height;
-
-//     rect_coords.emplace_back(x_start, y_start);
-//     rect_coords.emplace_back(x_start, y_start + scale_ * h);
-//     rect_coords.emplace_back(x_start + scale_ * w, y_start + scale_ * h);
-//     rect_coords.emplace_back(x_start, y_start);
-//     rect_coords.emplace_back(x_start + scale_ * w, y_start + scale_ * h);
-//     rect_coords.emplace_back(x_start + scale_ * w, y_start);
-//     texture_coords.emplace_back(x, y);
-//     texture_coords.emplace_back(x, y + h);
-//     texture_coords.emplace_back(x + w, y + h);
-//     texture_coords.emplace_back(x, y);
-//     texture_coords.emplace_back(x + w, y + h);
-//     texture_coords.emplace_back(x + w, y);
-//     x_start += scale_ * w;
-//     if (h < char_height) { char_height = h; }
-//   }
-
-//   num_points_ = rect_coords.size();
-
-//   vao_ = make_unique<GlVertexArray>();
-//   vao_->bind();
-//   SetVertexAttribute(0, rect_coords, vao_.get());
-//   SetVertexAttribute(1, texture_coords, vao_.get());
-//   vao_->release();
-
-//   sampler_index_ = 1;
-//   uniforms_to_override_.emplace_back(
-//       make_unique<GlUniform<int>>("source", sampler_index_));
-//   uniforms_to_override_.emplace_back(
-//       make_unique<GlUniform<vec3>>("anchor", pos_));
-//   ready_to_draw_ = true;
-// }
+Text::Text(ProgramPool* program_pool,
+           ProgramPool::ProgramIndex program_index,
+           Font::SharedPtr font,
+           const std::string& text,
+           const Eigen::Vector3f& anchor,
+           float height,
+           const Eigen::Vector3f& color,
+           std::size_t glyph_capacity)
+    : TextBatch{program_pool, program_index, std::move(font), height, color} {
+  AddLabel(text, anchor, glyph_capacity);
+}
 
 }  // namespace gl
@@ -8,9 +8,16 @@
 #include "glog/logging.h"
 
 #include "gl/scene/drawables/drawable.h"
+#include "gl/scene/font.h"
+#include "gl/scene/text_layout.h"
 #include "utils/eigen_utils.h"
 #include "utils/image.h"
 
+#include <Eigen/Geometry>
+
+#include <string>
+#include <vector>
+
 namespace gl {
 
 /// A class that is responsible for drawing points.
@@ -56,16 +63,22 @@ class CoordinateSystem : public Drawable {
 };
 
 /// Draw a rectangle with a texture attached to it.
+///
+/// The uv_rect holds min_u, min_v, max_u, max_v of the part of the texture
+/// to show, which allows to draw images stored in a texture atlas.
 class RectWithTexture : public Drawable {
  public:
   RectWithTexture(ProgramPool* program_pool,
                   ProgramPool::ProgramIndex program_index,
                   std::shared_ptr<gl::Texture> texture,
-                  const Eigen::Vector2f& size = {5.0f, 5.0f});
+                  const Eigen::Vector2f& size = {5.0f, 5.0f},
+                  const Eigen::Vector4f& uv_rect = {0.0f, 0.0f, 1.0f, 1.0f});
   void FillBuffers() override;
 
  private:
   Eigen::Vector2f size_;
+  /// Part of the texture to show, e.g., the place of an image in an atlas.
+  Eigen::Vector4f uv_rect_;
 };
 
 /// Draw a rectangle with a texture attached to it.
@@ -74,37 +87,133 @@ class ScreenRectWithTexture : public Drawable {
   ScreenRectWithTexture(ProgramPool* program_pool,
                         ProgramPool::ProgramIndex program_index,
                         std::shared_ptr<gl::Texture> texture,
-                        const Eigen::Vector2f& size = {1.0f, 1.0f});
+                        const Eigen::Vector2f& size = {1.0f, 1.0f},
+                        const Eigen::Vector4f& uv_rect = {0.0f,
+                                                          0.0f,
+                                                          1.0f,
+                                                          1.0f});
   void FillBuffers() override;
 
  private:
   Eigen::Vector2f size_;
+  /// Part of the texture to show, e.g., the place of an image in an atlas.
+  Eigen::Vector4f uv_rect_;
 };
 
-// /// Draw text.
-// class Text : public Drawable {
-//  public:
-//   Text(const std::string& text,
-//        const std::string& font_name,
-//        const glow::vec3& pos,
-//        float scale,
-//        Style draw_style);
-//   Text(const std::string& text,
-//        const std::string& font_name,
-//        const glow::vec3& pos,
-//        float scale = 4.0f);
-//   Text(const std::string& text,
-//        const std::string& font_name,
-//        const glow::vec2& pos,
-//        float scale = 0.5f);
-//   void FillBuffers() override;
-
-//  private:
-//   std::string text_;
-//   std::string font_name_;
-//   glow::vec3 pos_;
-//   float scale_;
-// };
+/// Draw many text labels that use the same font with a single instanced draw
+/// call.
+///
+/// Every glyph of every label is an instance of a quad. The instance buffer
+/// holds the anchor and the color of the label together with the corners of
+/// the glyph quad relative to the anchor and its texture coordinates, while
+/// the vertex shader builds the corners of the quads. Which program is used
+/// defines where the anchors are: text.vert projects them from the world and
+/// keeps the text facing the camera, text_on_screen.vert treats them as
+/// positions on the screen. The height of the text is in normalized device
+/// coordinates in both cases. Nothing has to be updated on the CPU when the
+/// camera moves.
+///
+/// Every label owns a range of glyph slots in the instance buffer. Changing
+/// a label that still fits into its slots only overwrites the instances of
+/// this label in place, so labels that change every frame, e.g., a frame
+/// rate, should reserve enough glyphs when they are added.
+class TextBatch : public Drawable {
+ public:
+  TextBatch(ProgramPool* program_pool,
+            ProgramPool::ProgramIndex program_index,
+            Font::SharedPtr font,
+            float height = 0.05f,
+            const Eigen::Vector3f& color = {1.0f, 1.0f, 1.0f});
+
+  /// Add a label to the batch and return its index. The label has space for
+  /// at least glyph_capacity glyphs. Its color is multiplied by the color of
+  /// the batch. The buffers are filled again before the next draw.
+  std::size_t AddLabel(const std::string& text,
+                       const Eigen::Vector3f& anchor,
+                       std::size_t glyph_capacity = 0ul,
+                       const Eigen::Vector3f& color = {1.0f, 1.0f, 1.0f});
+
+  /// Change the text of a label. If the new text fits into the glyphs
+  /// reserved for the label, its instances are updated in place, otherwise
+  /// the buffers are filled again before the next draw.
+  void SetLabelText(std::size_t label_index, const std::string& text);
+
+  /// Change the color of a label in place.
+  void SetLabelColor(std::size_t label_index, const Eigen::Vector3f& color);
+
+  /// Show or hide the labels, one flag per label. Only the labels that change
+  /// their visibility are updated in place.
+  void SetLabelsVisible(const std::vector<bool>& visible);
+
+  const Eigen::Vector3f& label_anchor(std::size_t label_index) const {
+    return labels_.at(label_index).anchor;
+  }
+
+  /// Extent of the label around its anchor in normalized device coordinates.
+  Eigen::AlignedBox2f ComputeLabelExtent(std::size_t label_index);
+
+  /// Remove all the labels from the batch.
+  void ClearLabels();
+
+  /// Take the layouts of the texts from a cache, which is not owned.
+  inline void SetLayoutCache(TextLayoutCache* layout_cache) noexcept {
+    layout_cache_ = layout_cache;
+  }
+
+  std::size_t number_of_labels() const noexcept { return labels_.size(); }
+  std::size_t number_of_glyphs() const noexcept { return number_of_glyphs_; }
+
+  void FillBuffers() override;
+
+ private:
+  struct Label {
+    std::string text;
+    Eigen::Vector3f anchor;
+    std::size_t glyph_capacity;
+    Eigen::Vector3f color;
+    std::size_t first_glyph{};
+    std::size_t number_of_glyphs{};
+    bool visible{true};
+    /// Layout of the text in the buffers.
+    std::shared_ptr<const TextLayout> layout{};
+  };
+
+  std::shared_ptr<const TextLayout> LayoutText(const std::string& text);
+
+  /// Write the instances of all glyph slots of a label. Unused slots and
+  /// hidden labels become degenerate quads that are not rasterized.
+  static void WriteLabelInstances(const Label& label, float* instances);
+
+  /// Overwrite the first glyphs of the label in the instance buffer.
+  void UpdateLabelInstances(const Label& label, std::size_t number_of_glyphs);
+
+  Font::SharedPtr font_;
+  float height_;
+  std::vector<Label> labels_;
+  std::size_t number_of_glyphs_{};
+
+  TextLayoutCache* layout_cache_{nullptr};
+  std::shared_ptr<Buffer> instance_buffer_{nullptr};
+  /// Scratch space for the instances of a single label that is updated.
+  std::vector<float> label_instances_;
+};
+
+/// Draw a single string of text.
+class Text : public TextBatch {
+ public:
+  Text(ProgramPool* program_pool,
+       ProgramPool::ProgramIndex program_index,
+       Font::SharedPtr font,
+       const std::string& text,
+       const Eigen::Vector3f& anchor = Eigen::Vector3f::Zero(),
+       float height = 0.05f,
+       const Eigen::Vector3f& color = {1.0f, 1.0f, 1.0f},
+       std::size_t glyph_capacity = 0ul);
+
+  /// Change the text. This is cheap as long as the text fits into the glyph
+  /// capacity.
+  inline void SetText(const std::string& text) { SetLabelText(0ul, text); }
+};
 
 }  // namespace gl
 
@@ -29,22 +29,39 @@ void Drawable::Draw() {
   CHECK(program_pool_) << "Need a program pool to draw.";
   CHECK(program_index_) << "Need a program index to draw.";
 
+  // The allocator keeps textures bound between draws, so they are only
+  // bound again if their unit was taken by another texture.
+  const bool use_allocator{texture_ && texture_unit_allocator_};
+  if (use_allocator) {
+    const auto unit{texture_unit_allocator_->Bind(texture_, sampler_)};
+    if (texture_uniform_index_) {
+      program_pool_->UpdateUniform(
+          program_index_.value(), texture_uniform_index_.value(), unit);
+    }
+  }
   program_pool_->UseProgram(program_index_.value());
-  if (texture_) { texture_->Bind(); }
+  if (texture_ && !use_allocator) { texture_->Bind(); }
+  if (blending_) {
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  }
 
   vao_->Draw(mode_);
 
+  if (blending_) { glDisable(GL_BLEND); }
+
   // Set the line and point sizes.
   glPointSize(point_size_);
   glLineWidth(point_size_);
 
-  if (texture_) { texture_->UnBind(); }
+  if (texture_ && !use_allocator) { texture_->UnBind(); }
 }
 
 void Drawable::ChangeColor(const Eigen::Vector3f& color) noexcept {
   color_ = color;
   if (color_uniform_index_) {
-    program_pool_->UpdateUniformInActiveProgram(color_uniform_index_, color_);
+    program_pool_->UpdateUniform(
+        program_index_.value(), color_uniform_index_.value(), color_);
   }
 }
 
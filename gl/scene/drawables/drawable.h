@@ -8,7 +8,9 @@
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
 #include "gl/core/program.h"
+#include "gl/core/sampler.h"
 #include "gl/core/texture.h"
+#include "gl/core/texture_unit_allocator.h"
 #include "gl/core/vertex_array_buffer.h"
 #include "gl/scene/program_pool.h"
 #include "gl/utils/eigen_traits.h"
@@ -17,6 +19,8 @@
 #include <Eigen/Core>
 
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 ABSL_DECLARE_FLAG(float, drawable_point_size);
@@ -58,13 +62,26 @@ class Drawable {
   /// Change the color of this drawable if it supports color.
   void ChangeColor(const Eigen::Vector3f& color) noexcept;
 
+  /// Let the allocator pick the texture unit for the texture of this
+  /// drawable. Without an allocator the texture is bound to its identifier.
+  inline void SetTextureUnitAllocator(
+      TextureUnitAllocator* texture_unit_allocator) noexcept {
+    texture_unit_allocator_ = texture_unit_allocator;
+  }
+
+  /// Sample the texture with a shared sampler instead of the parameters
+  /// stored in the texture. Only used together with an allocator.
+  inline void SetSampler(std::shared_ptr<Sampler> sampler) noexcept {
+    sampler_ = std::move(sampler);
+  }
+
   // TODO(igor): this somehow smells bad. Do I need this function? What do I
   // need it for?
   inline void SetModel(const Eigen::Matrix4f& model) const {
     CHECK(program_index_);
-    CHECK_GT(model_uniform_index_, 0UL);
-    program_pool_->UseProgram(program_index_.value());
-    program_pool_->UpdateUniformInActiveProgram(model_uniform_index_, model);
+    CHECK(model_uniform_index_) << "Model uniform is not set up.";
+    program_pool_->UpdateUniform(
+        program_index_.value(), model_uniform_index_.value(), model);
   }
 
  protected:
@@ -74,17 +91,23 @@ class Drawable {
   std::optional<ProgramPool::ProgramIndex> program_index_{};
 
   /// Model matrix that defines where this drawable is situated in the world.
-  std::size_t model_uniform_index_{};
+  std::optional<std::size_t> model_uniform_index_{};
   /// A uniform for tweaking the projection-view matrix.
-  std::size_t projection_view_uniform_index_{};
+  std::optional<std::size_t> projection_view_uniform_index_{};
   /// A uniform to set color to the points.
-  std::size_t color_uniform_index_{};
+  std::optional<std::size_t> color_uniform_index_{};
+  /// A sampler uniform that gets the texture unit of the texture.
+  std::optional<std::size_t> texture_uniform_index_{};
 
   /// This maps to the OpenGL modes, e.g. GL_TRIANGLES.
   GLenum mode_{GL_NONE};
 
   /// A drawable can share a texture that it draws.
   std::shared_ptr<Texture> texture_{nullptr};
+  /// An optional sampler to use with the texture.
+  std::shared_ptr<Sampler> sampler_{nullptr};
+  /// Picks texture units for textures, not owned.
+  TextureUnitAllocator* texture_unit_allocator_{nullptr};
   /// A drawable owns a vertex array object.
   std::unique_ptr<VertexArrayBuffer> vao_{nullptr};
 
@@ -92,6 +115,10 @@ class Drawable {
   /// is used to trigger when we want to fill the buffers.
   bool ready_to_draw_{false};
 
+  /// Blend the drawable with what is already drawn using its alpha, e.g., to
+  /// draw text with transparent background around the glyphs.
+  bool blending_{false};
+
   /// Size of points and lines used when drawing.
   float point_size_{};
   /// Color of this drawable.
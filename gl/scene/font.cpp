@@ -3,87 +3,221 @@
 // Email: igor.bogoslavskyi@uni-bonn.de.
 
 #include "gl/scene/font.h"
-#include "absl/strings/str_split.h"
+#include "utils/file_utils.h"
 
-#include <fstream>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <filesystem>
 #include <vector>
 
 namespace {
 const char kFontExtension[]{".fnt"};
 const char kImageExtension[]{".png"};
-const char kPathDelimeter{'/'};
+const char kDistanceFieldExtension[]{".pgm"};
+
+constexpr std::size_t kTokensPerGlyphLine{9ul};
+
+bool EndsWith(std::string_view text, std::string_view suffix) {
+  return text.size() >= suffix.size() &&
+         text.substr(text.size() - suffix.size()) == suffix;
+}
+
+/// Cut the next line from the contents. Handles both Unix and Windows line
+/// endings.
+std::string_view NextLine(std::string_view* contents) {
+  const auto end_of_line{contents->find('\n')};
+  auto line{contents->substr(0ul, end_of_line)};
+  contents->remove_prefix(end_of_line == std::string_view::npos
+                              ? contents->size()
+                              : end_of_line + 1ul);
+  if (!line.empty() && line.back() == '\r') { line.remove_suffix(1ul); }
+  return line;
+}
+
+/// Split a line into tokens separated by tabs or spaces. Only the first N
+/// tokens are stored, but all of them are counted.
+template <std::size_t N>
+std::size_t Tokenize(std::string_view line,
+                     std::array<std::string_view, N>* tokens) {
+  constexpr std::string_view kDelimiters{"\t "};
+  std::size_t count{};
+  while (true) {
+    const auto begin{line.find_first_not_of(kDelimiters)};
+    if (begin == std::string_view::npos) { break; }
+    line.remove_prefix(begin);
+    const auto end{std::min(line.find_first_of(kDelimiters), line.size())};
+    if (count < N) { (*tokens)[count] = line.substr(0ul, end); }
+    ++count;
+    line.remove_prefix(end);
+  }
+  return count;
+}
+
+std::optional<int> ParseInt(std::string_view token) {
+  int value{};
+  const auto* const end{token.data() + token.size()};
+  const auto [parsed_end, error]{std::from_chars(token.data(), end, value)};
+  if (error != std::errc{} || parsed_end != end) { return {}; }
+  return value;
+}
+
 }  // namespace
 
 namespace gl {
 
 Font::Font(const std::string& file_name) {
-  CHECK(absl::EndsWith(file_name, kFontExtension))
-      << "We only read " << kFontExtension << " files";
-
-  auto ConcatenateWithDelimeter = [](const std::string& a,
-                                     const std::string& b) {
-    if (a.empty()) { return b; }
-    return a + kPathDelimeter + b;
-  };
-  const std::vector<std::string> split_path{
-      absl::StrSplit(file_name, kPathDelimeter)};
-  const auto folder{std::accumulate(split_path.begin(),
-                                    split_path.end() - 1,
-                                    std::string{},
-                                    ConcatenateWithDelimeter)};
-
-  const auto font_content{utils::ReadFileContents(file_name)};
+  auto font{CreateFromFile(file_name)};
+  CHECK(font) << "Cannot load font from " << file_name;
+  *this = std::move(*font);
+}
 
+std::optional<Font> Font::CreateFromFile(const std::string& file_name) {
+  if (!EndsWith(file_name, kFontExtension)) {
+    LOG(WARNING) << "We only read " << kFontExtension << " files, got "
+                 << file_name;
+    return {};
+  }
+  const auto contents{utils::ReadFileContents(file_name)};
+  if (!contents) {
+    LOG(WARNING) << "Cannot read font file " << file_name;
+    return {};
+  }
   LOG(INFO) << "Reading font from " << file_name;
-  std::ifstream file(file_name);
-
-  auto SplitNextLine = [](std::ifstream* file) -> std::vector<std::string> {
-    std::string line;
-    if (!std::getline(*file, line, '\n')) { return {}; }
-    return absl::StrSplit(line, absl::ByAnyChar("\t "));
-  };
-
-  auto GetTextureImageName = [&SplitNextLine](std::ifstream* file) {
-    std::vector<std::string> split_string{SplitNextLine(file)};
-    CHECK_EQ(split_string.size(), static_cast<size_t>(2))
-        << "Wrong line format.";
-    CHECK(absl::EndsWith(split_string[1], kImageExtension))
-        << "Texture must be " << kImageExtension;
-    return split_string[1];
-  };
-
-  auto GetFontName = [&SplitNextLine](std::ifstream* file) {
-    std::vector<std::string> split_string{SplitNextLine(file)};
-    return std::accumulate(
-        split_string.begin(), split_string.end() - 1, std::string(""));
-  };
-
-  // Load image.
-  const auto image_name{GetTextureImageName(&file)};
-  const auto path_to_image{folder + kPathDelimeter + image_name};
-  const auto texture{utils::Image::CreateFrom(path_to_image)};
-  CHECK(texture.has_value()) << "Could not load image: " << path_to_image;
-  font_texture_ = texture.value();
-  // Get font name for storage purposes.
-  name_ = GetFontName(&file);
+  return CreateFromContents(
+      *contents, std::filesystem::path{file_name}.parent_path().string());
+}
+
+std::optional<Font> Font::CreateFromContents(std::string_view contents,
+                                             const std::string& folder) {
+  // The first line holds the name of the texture image.
+  std::array<std::string_view, kTokensPerGlyphLine> tokens{};
+  if (Tokenize(NextLine(&contents), &tokens) != 2ul ||
+      !(EndsWith(tokens[1], kImageExtension) ||
+        EndsWith(tokens[1], kDistanceFieldExtension))) {
+    LOG(WARNING) << "Wrong texture line format, expected 'textures: *"
+                 << kImageExtension << "' or 'textures: *"
+                 << kDistanceFieldExtension << "'.";
+    return {};
+  }
+  const bool is_distance_field{EndsWith(tokens[1], kDistanceFieldExtension)};
+  const auto path_to_image{std::filesystem::path{folder} /
+                           std::string{tokens[1]}};
+
+  // The second line holds the name of the font followed by its size. The name
+  // is stored without spaces.
+  Font font{};
+  const auto number_of_name_tokens{Tokenize(NextLine(&contents), &tokens)};
+  if (number_of_name_tokens > tokens.size()) {
+    LOG(WARNING) << "Font name is too long.";
+    return {};
+  }
+  for (std::size_t i = 0; i + 1ul < number_of_name_tokens; ++i) {
+    font.name_.append(tokens[i]);
+  }
+
+  // Distance fields are stored as raw grayscale images, which are mapped
+  // instead of decoded.
+  const auto texture{is_distance_field
+                         ? utils::Image::CreateFromMappedFile(path_to_image)
+                         : utils::Image::CreateFrom(path_to_image)};
+  if (!texture || (is_distance_field && texture->number_of_channels() != 1)) {
+    LOG(WARNING) << "Could not load image: " << path_to_image;
+    return {};
+  }
+  font.font_texture_ = texture.value();
+  font.is_distance_field_ = is_distance_field;
 
   // Read all the chars and store their Texture coordinates. These are different
-  // from image coordinates and are intended to be used with OpenGL.
-  const float kYNormalizer{1.0f / font_texture_.height()};
-  const float kXNormalizer{1.0f / font_texture_.width()};
-  while (true) {
-    const auto split{SplitNextLine(&file)};
-    if (split.size() != 9ul) {
-      LOG(INFO) << "Read all relevant chars.";
+  // from image coordinates and are intended to be used with OpenGL. The glyphs
+  // end with the first line of another format, e.g., the kerning pairs.
+  const float kYNormalizer{1.0f / font.font_texture_.height()};
+  const float kXNormalizer{1.0f / font.font_texture_.width()};
+  for (int line_number = 3; !contents.empty(); ++line_number) {
+    if (Tokenize(NextLine(&contents), &tokens) != kTokensPerGlyphLine) {
       break;
     }
-    CHECK_GE(split.size(), 5ul) << "Wrong format. ";
-    TextureCoords coords{kXNormalizer * std::stoi(split[1]),
-                         1.0f - kYNormalizer * std::stoi(split[2]),
-                         kXNormalizer * std::stoi(split[3]),
-                         -kYNormalizer * std::stoi(split[4])};
-    char_coords_.emplace(std::stoi(split[0]), coords);
+    std::array<int, kTokensPerGlyphLine - 1ul> numbers{};
+    for (std::size_t i = 0; i < numbers.size(); ++i) {
+      const auto number{ParseInt(tokens[i])};
+      if (!number) {
+        LOG(WARNING) << "Cannot parse '" << tokens[i] << "' on line "
+                     << line_number << " as a number.";
+        return {};
+      }
+      numbers[i] = *number;
+    }
+    const auto [code, x, y, width, height, x_offset, y_offset, advance]{
+        numbers};
+    // Only single byte symbols fit into the glyph table.
+    if (code < 0 || code >= static_cast<int>(kNumberOfGlyphs)) { continue; }
+    if (font.has_glyph_[code]) { continue; }
+    TextureCoords coords{kXNormalizer * x,
+                         1.0f - kYNormalizer * y,
+                         kXNormalizer * width,
+                         -kYNormalizer * height,
+                         static_cast<float>(x_offset),
+                         static_cast<float>(y_offset),
+                         static_cast<float>(width),
+                         static_cast<float>(height),
+                         static_cast<float>(advance)};
+    font.line_height_ = std::max(font.line_height_,
+                                 coords.y_offset + coords.height_in_pixels);
+    font.glyphs_[code] = coords;
+    font.has_glyph_[code] = true;
+  }
+  return font;
+}
+
+std::vector<Font::GlyphQuad> Font::LayoutString(std::string_view text) const {
+  std::vector<GlyphQuad> quads{};
+  quads.reserve(text.size());
+  float pen_x{};
+  float line_top{line_height_};
+  for (const char symbol : text) {
+    if (symbol == '\n') {
+      pen_x = 0.0f;
+      line_top -= line_height_;
+      continue;
+    }
+    const auto index{ToIndex(symbol)};
+    if (!has_glyph_[index]) { continue; }
+    const auto& glyph{glyphs_[index]};
+    if (symbol != ' ') {
+      const float min_x{pen_x + glyph.x_offset};
+      const float max_y{line_top - glyph.y_offset};
+      quads.push_back({min_x,
+                       max_y - glyph.height_in_pixels,
+                       min_x + glyph.width_in_pixels,
+                       max_y,
+                       glyph.x,
+                       glyph.y + glyph.height,
+                       glyph.x + glyph.width,
+                       glyph.y});
+    }
+    pen_x += glyph.advance;
   }
+  return quads;
+}
+
+const std::shared_ptr<Texture>& Font::GetGlTexture() const {
+  if (gl_texture_) { return gl_texture_; }
+  // The texture coordinates expect the first row of the image at the top.
+  auto image{utils::Image::CreateFromData(font_texture_.width(),
+                                          font_texture_.height(),
+                                          font_texture_.number_of_channels(),
+                                          font_texture_.data())};
+  image.FlipVertically();
+  gl_texture_ = Texture::Builder{Texture::Type::kTexture2D,
+                                 Texture::Identifier::kTexture0}
+                    .WithSaneDefaults()
+                    .WithWrapping(Texture::WrappingDirection::kWrapS,
+                                  Texture::WrappingMode::kClampToEdge)
+                    .WithWrapping(Texture::WrappingDirection::kWrapT,
+                                  Texture::WrappingMode::kClampToEdge)
+                    .WithImage(image)
+                    .Build();
+  return gl_texture_;
 }
 
 }  // namespace gl
@@ -5,20 +5,31 @@
 #ifndef CODE_OPENGL_TUTORIALS_GL_SCENE_FONT_H_
 #define CODE_OPENGL_TUTORIALS_GL_SCENE_FONT_H_
 
+#include "gl/core/texture.h"
 #include "glog/logging.h"
 
 #include "utils/image.h"
 
-#include <map>
+#include <array>
+#include <bitset>
 #include <memory>
-#include <numeric>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace gl {
 
 /// A class to work with font generated by https://github.com/scriptum/UBFG
 /// The idea here is that we cut out the images of letters given a texture and
 /// where these letters are in the texture.
+///
+/// If the texture of the font is a *.pgm file it holds a signed distance field
+/// of the glyphs generated by make_sdf_font instead of their images. Such a
+/// font looks sharp at any size when drawn with text_sdf.frag.
+///
+/// Glyphs are stored in a table indexed by the byte value of the symbol, so
+/// looking a glyph up does not depend on the number of glyphs in the font.
 class Font {
   struct TextureCoords;
 
@@ -26,33 +37,100 @@ class Font {
   using UniquePtr = std::unique_ptr<Font>;
   using SharedPtr = std::shared_ptr<Font>;
 
+  /// A quad of a single glyph of a laid out string. The positions are in
+  /// pixels of the font texture, the origin is at the bottom left corner of
+  /// the first line and y goes up.
+  struct GlyphQuad {
+    float min_x;
+    float min_y;
+    float max_x;
+    float max_y;
+    float min_u;
+    float min_v;
+    float max_u;
+    float max_v;
+  };
+
+  /// Load a font and fail if it cannot be loaded.
   explicit Font(const std::string& file_name);
 
+  /// Load a font from a *.fnt file. Returns an empty optional and logs the
+  /// reason if the file cannot be read or parsed.
+  static std::optional<Font> CreateFromFile(const std::string& file_name);
+
+  /// Parse the contents of a *.fnt file. The texture image is loaded from the
+  /// folder.
+  static std::optional<Font> CreateFromContents(std::string_view contents,
+                                                const std::string& folder);
+
   /// Get the coordinates of the characted in the texture.
   inline const TextureCoords& GetCharCoords(char symbol) const {
-    CHECK(char_coords_.count(symbol))
+    CHECK(HasSymbol(symbol))
         << "Symbol '" << symbol << "' is not in font '" << name_ << "'.";
-    return char_coords_.at(symbol);
+    return glyphs_[ToIndex(symbol)];
   }
 
+  /// Check if the font has an image of this symbol.
+  inline bool HasSymbol(char symbol) const {
+    return has_glyph_[ToIndex(symbol)];
+  }
+
+  /// Get the quads of all the glyphs of a string at once. Every new line
+  /// starts one line height lower. Spaces only move the pen and produce no
+  /// quads. Symbols missing in the font have no advance, so they are skipped
+  /// without moving the pen.
+  std::vector<GlyphQuad> LayoutString(std::string_view text) const;
+
   /// Name of this font.
   const std::string& name() const { return name_; }
 
   /// Get the texture.
   const utils::Image& texture() const { return font_texture_; }
 
+  /// Get the OpenGL texture with all the symbols. It is created on first use,
+  /// so this must be called from the thread that owns the OpenGL context.
+  const std::shared_ptr<Texture>& GetGlTexture() const;
+
+  /// Check if the texture stores distances to the glyph edges, where 0.5 is
+  /// the edge and larger values are inside of the glyphs.
+  bool is_distance_field() const { return is_distance_field_; }
+
+  /// Height of a line of text in pixels of the font texture.
+  float line_height() const { return line_height_; }
+
  private:
+  Font() = default;
+
   struct TextureCoords {
-    float x;
-    float y;
-    float width;
-    float height;
+    float x{};
+    float y{};
+    float width{};
+    float height{};
+    /// Placement of the symbol relative to the pen position in pixels. The y
+    /// offset is measured down from the top of the line.
+    float x_offset{};
+    float y_offset{};
+    float width_in_pixels{};
+    float height_in_pixels{};
+    /// How far to move the pen after this symbol in pixels.
+    float advance{};
   };
 
   std::string name_;
 
   utils::Image font_texture_;
-  std::map<char, TextureCoords> char_coords_;
+  static constexpr std::size_t kNumberOfGlyphs{256ul};
+
+  static std::size_t ToIndex(char symbol) noexcept {
+    return static_cast<unsigned char>(symbol);
+  }
+
+  std::array<TextureCoords, kNumberOfGlyphs> glyphs_{};
+  std::bitset<kNumberOfGlyphs> has_glyph_{};
+  float line_height_{};
+  bool is_distance_field_{};
+
+  mutable std::shared_ptr<Texture> gl_texture_{};
 };
 
 }  // namespace gl
@@ -0,0 +1,124 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+// Compares laying out many short labels with Font::LayoutString against
+// looking every glyph up in a std::map, which is how Font stored its glyphs
+// before.
+
+#include "gl/scene/font.h"
+
+#include "glog/logging.h"
+
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace {
+
+constexpr int kNumberOfLabels{10000};
+constexpr int kLabelLength{16};
+constexpr int kRepetitions{20};
+
+using Clock = std::chrono::steady_clock;
+using GlyphQuad = gl::Font::GlyphQuad;
+
+std::vector<std::string> GenerateLabels(const gl::Font& font) {
+  std::string alphabet{};
+  for (int code = 0; code < 128; ++code) {
+    const auto symbol{static_cast<char>(code)};
+    if (font.HasSymbol(symbol)) { alphabet.push_back(symbol); }
+  }
+  std::mt19937 generator{42u};
+  std::uniform_int_distribution<std::size_t> distribution{
+      0ul, alphabet.size() - 1ul};
+  std::vector<std::string> labels(kNumberOfLabels);
+  for (auto& label : labels) {
+    for (int i = 0; i < kLabelLength; ++i) {
+      label.push_back(alphabet[distribution(generator)]);
+    }
+  }
+  return labels;
+}
+
+/// Lay out a string by looking up every symbol in a map with a check.
+template <typename MapT>
+std::vector<GlyphQuad> LayoutWithMap(const MapT& glyphs,
+                                     float line_height,
+                                     const std::string& text) {
+  std::vector<GlyphQuad> quads{};
+  quads.reserve(text.size());
+  float pen_x{};
+  for (const char symbol : text) {
+    if (!glyphs.count(symbol)) { continue; }
+    CHECK(glyphs.count(symbol));
+    const auto& glyph{glyphs.at(symbol)};
+    if (symbol != ' ') {
+      const float min_x{pen_x + glyph.x_offset};
+      const float max_y{line_height - glyph.y_offset};
+      quads.push_back({min_x,
+                       max_y - glyph.height_in_pixels,
+                       min_x + glyph.width_in_pixels,
+                       max_y,
+                       glyph.x,
+                       glyph.y + glyph.height,
+                       glyph.x + glyph.width,
+                       glyph.y});
+    }
+    pen_x += glyph.advance;
+  }
+  return quads;
+}
+
+template <typename FunctionT>
+void Measure(const char* name, int number_of_glyphs, FunctionT&& function) {
+  std::size_t number_of_quads{};
+  const auto start{Clock::now()};
+  for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+    number_of_quads += function();
+  }
+  const std::chrono::duration<double, std::nano> duration{Clock::now() -
+                                                          start};
+  std::printf("%-16s %8.2f ns per glyph (%zu quads)\n",
+              name,
+              duration.count() / (kRepetitions * number_of_glyphs),
+              number_of_quads);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  google::InitGoogleLogging(argv[0]);
+  const gl::Font font{"gl/scene/fonts/ubuntu.fnt"};
+  const auto labels{GenerateLabels(font)};
+
+  using Coords = std::decay_t<decltype(font.GetCharCoords(' '))>;
+  std::map<char, Coords> glyph_map{};
+  for (int code = 0; code < 256; ++code) {
+    const auto symbol{static_cast<char>(code)};
+    if (font.HasSymbol(symbol)) {
+      glyph_map.emplace(symbol, font.GetCharCoords(symbol));
+    }
+  }
+
+  const int number_of_glyphs{kNumberOfLabels * kLabelLength};
+  Measure("std::map", number_of_glyphs, [&labels, &glyph_map, &font]() {
+    std::size_t count{};
+    for (const auto& label : labels) {
+      count += LayoutWithMap(glyph_map, font.line_height(), label).size();
+    }
+    return count;
+  });
+  Measure("LayoutString", number_of_glyphs, [&labels, &font]() {
+    std::size_t count{};
+    for (const auto& label : labels) {
+      count += font.LayoutString(label).size();
+    }
+    return count;
+  });
+  return 0;
+}
@@ -7,6 +7,7 @@
 #include <glog/logging.h>
 
 #include <memory>
+#include <utility>
 
 namespace gl {
 
@@ -16,19 +17,69 @@ FontPool& FontPool::Instance() {
 }
 
 bool FontPool::HasFont(const std::string& font_tag) const {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (fonts_.count(font_tag) > 0) { return true; }
+  }
+  WaitForPendingFonts();
+  std::lock_guard<std::mutex> lock{mutex_};
   return fonts_.count(font_tag) > 0;
 }
 
-const Font::SharedPtr& FontPool::Get(const std::string& font_tag) const {
-  CHECK(fonts_.count(font_tag)) << "Must load the font before using it.";
+Font::SharedPtr FontPool::Get(const std::string& font_tag) const {
+  CHECK(HasFont(font_tag)) << "Must load the font before using it.";
+  std::lock_guard<std::mutex> lock{mutex_};
   return fonts_.at(font_tag);
 }
 
-std::string FontPool::LoadFont(const std::string& font_path) {
-  auto font = std::make_shared<Font>(font_path);
-  font_names_.push_back(font->name());
-  fonts_.emplace(font->name(), std::move(font));
-  return font_names_.back();
+std::shared_future<FontPool::FontName> FontPool::PreloadFont(
+    const std::string& font_path) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  const auto iter{loads_by_path_.find(font_path)};
+  if (iter != loads_by_path_.end()) { return iter->second; }
+  if (!worker_) { worker_ = std::make_unique<utils::ThreadPool>(1ul); }
+  auto font_name{worker_
+                     ->Enqueue([this, font_path]() {
+                       return AddFont(Font::CreateFromFile(font_path));
+                     })
+                     .share()};
+  loads_by_path_.emplace(font_path, font_name);
+  return font_name;
+}
+
+std::optional<std::string> FontPool::LoadFont(const std::string& font_path) {
+  return PreloadFont(font_path).get();
+}
+
+std::vector<std::string> FontPool::font_names() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return font_names_;
+}
+
+std::map<std::string, Font::SharedPtr> FontPool::fonts() const {
+  std::lock_guard<std::mutex> lock{mutex_};
+  return fonts_;
+}
+
+FontPool::FontName FontPool::AddFont(std::optional<Font> font) {
+  if (!font) { return {}; }
+  auto shared_font{std::make_shared<Font>(std::move(*font))};
+  auto name{shared_font->name()};
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (fonts_.emplace(name, std::move(shared_font)).second) {
+    font_names_.push_back(name);
+  }
+  return name;
+}
+
+void FontPool::WaitForPendingFonts() const {
+  std::vector<std::shared_future<FontName>> loads{};
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    for (const auto& [path, load] : loads_by_path_) { loads.push_back(load); }
+  }
+  // The workers need the lock to add the fonts, so wait without holding it.
+  for (const auto& load : loads) { load.wait(); }
 }
 
 }  // namespace gl
@@ -6,17 +6,29 @@
 #define CODE_OPENGL_TUTORIALS_GL_SCENE_FONT_POOL_H_
 
 #include "gl/scene/font.h"
+#include "utils/thread_pool.h"
 
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
 namespace gl {
 
-/// Container for all available fonts.
+/// Container for all available fonts. It can be used from multiple threads.
+///
+/// Fonts are parsed and their images are decoded on a worker thread, so
+/// preloading a font does not block the caller. The OpenGL texture of a font
+/// is only created when a drawable first uses the font, which happens on the
+/// thread that owns the OpenGL context.
 class FontPool {
  public:
+  /// Name of a loaded font or an empty optional if it could not be loaded.
+  using FontName = std::optional<std::string>;
+
   static FontPool& Instance();
 
   FontPool(const FontPool&) = delete;
@@ -24,20 +36,38 @@ class FontPool {
   FontPool& operator=(const FontPool&) = delete;
   FontPool& operator=(FontPool&&) = delete;
 
-  /// Get the font with this tag.
-  const Font::SharedPtr& Get(const std::string& font_tag) const;
-  /// Load a font from a *.fnt file and return its name.
-  std::string LoadFont(const std::string& font_path);
-  /// Check that the font is present.
+  /// Get the font with this tag. Waits for the fonts that are still loading
+  /// if there is no such font yet.
+  Font::SharedPtr Get(const std::string& font_tag) const;
+  /// Start loading a font from a *.fnt file on a worker thread. A font is
+  /// only loaded once, so preloading the same path again returns the same
+  /// future.
+  std::shared_future<FontName> PreloadFont(const std::string& font_path);
+  /// Load a font from a *.fnt file and return its name. Returns an empty
+  /// optional if the font cannot be loaded.
+  std::optional<std::string> LoadFont(const std::string& font_path);
+  /// Check that the font is present. Waits for the fonts that are still
+  /// loading if there is no such font yet.
   bool HasFont(const std::string& font_tag) const;
 
-  const std::vector<std::string>& font_names() const { return font_names_; }
-  const std::map<std::string, Font::SharedPtr>& fonts() const { return fonts_; }
+  std::vector<std::string> font_names() const;
+  std::map<std::string, Font::SharedPtr> fonts() const;
 
  private:
   FontPool() = default;
-  std::vector<std::string> font_names_;
-  std::map<std::string, Font::SharedPtr> fonts_;
+
+  /// Add a loaded font to the pool and return its name.
+  FontName AddFont(std::optional<Font> font);
+  /// Block until all fonts that were requested so far are loaded.
+  void WaitForPendingFonts() const;
+
+  mutable std::mutex mutex_{};
+  std::vector<std::string> font_names_{};
+  std::map<std::string, Font::SharedPtr> fonts_{};
+  std::map<std::string, std::shared_future<FontName>> loads_by_path_{};
+  /// Created on the first load. Declared last to finish the loads that are
+  /// still running before the fonts are destroyed.
+  std::unique_ptr<utils::ThreadPool> worker_{};
 };
 
 }  // namespace gl
@@ -5,6 +5,11 @@
 #include "gl/scene/font_pool.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace gl;
 
 TEST(FontPoolTest, Simple) {
@@ -15,3 +20,40 @@ TEST(FontPoolTest, Simple) {
   const auto font{FontPool::Instance().Get("UbuntuNerdFont")};
   EXPECT_EQ(font->name(), "UbuntuNerdFont");
 }
+
+TEST(FontPoolTest, MissingFont) {
+  EXPECT_FALSE(FontPool::Instance().LoadFont("non_existing.fnt").has_value());
+}
+
+TEST(FontPoolTest, PreloadFont) {
+  auto& pool{FontPool::Instance()};
+  // Other tests share the pool, so only use the font they load too.
+  const auto font_name{pool.PreloadFont("gl/scene/fonts/ubuntu.fnt")};
+  ASSERT_TRUE(font_name.get().has_value());
+  EXPECT_EQ(font_name.get().value(),
+            pool.Get(font_name.get().value())->name());
+  // The font is only loaded once.
+  EXPECT_EQ(font_name.get(),
+            pool.PreloadFont("gl/scene/fonts/ubuntu.fnt").get());
+  const auto font_names{pool.font_names()};
+  EXPECT_EQ(1,
+            std::count(font_names.begin(),
+                       font_names.end(),
+                       font_name.get().value()));
+  EXPECT_FALSE(pool.PreloadFont("non_existing.fnt").get().has_value());
+}
+
+TEST(FontPoolTest, GetWaitsForPreloadedFonts) {
+  auto& pool{FontPool::Instance()};
+  const auto font_name{pool.PreloadFont("gl/scene/fonts/ubuntu.fnt")};
+  std::vector<std::thread> threads{};
+  std::vector<Font::SharedPtr> fonts(4);
+  for (auto& font : fonts) {
+    threads.emplace_back([&pool, &font, font_name]() {
+      font = pool.Get(font_name.get().value_or(""));
+    });
+  }
+  for (auto& thread : threads) { thread.join(); }
+  for (const auto& font : fonts) { EXPECT_EQ(fonts.front(), font); }
+  EXPECT_NE(nullptr, fonts.front());
+}
@@ -14,3 +14,66 @@ TEST(FontTest, Simple) {
   EXPECT_EQ(font.texture().height(), 512);
   EXPECT_GT(font.GetCharCoords('a').width, 0);
 }
+
+TEST(FontTest, LayoutString) {
+  Font font{"gl/scene/fonts/ubuntu.fnt"};
+  EXPECT_TRUE(font.HasSymbol('a'));
+  EXPECT_FALSE(font.HasSymbol('\t'));
+  const auto quads{font.LayoutString("ab\tc\na")};
+  // The tab is not in the font, so it is skipped.
+  ASSERT_EQ(4ul, quads.size());
+  const auto& a_coords{font.GetCharCoords('a')};
+  EXPECT_FLOAT_EQ(a_coords.x, quads[0].min_u);
+  EXPECT_FLOAT_EQ(a_coords.x + a_coords.width, quads[0].max_u);
+  EXPECT_LT(quads[0].max_x, quads[1].max_x);
+  EXPECT_LT(quads[1].max_x, quads[2].max_x);
+  // A new line starts at the left and one line lower.
+  EXPECT_FLOAT_EQ(quads[0].min_x, quads[3].min_x);
+  EXPECT_FLOAT_EQ(quads[0].max_y - font.line_height(), quads[3].max_y);
+  EXPECT_TRUE(font.LayoutString("  ").empty());
+}
+
+TEST(FontTest, ParseContents) {
+  const auto font{Font::CreateFromContents(
+      "textures: ubuntu.png\r\n"
+      "Ubuntu Nerd Font 40pt\r\n"
+      "97\t55\t236\t27\t59\t1\t0\t28\t0\r\n"
+      "98\t174\t177\t29\t59\t3\t0\t31\t0\r\n"
+      "kerning pairs:\r\n"
+      "32\t102\t1\r\n",
+      "gl/scene/fonts")};
+  ASSERT_TRUE(font.has_value());
+  EXPECT_EQ("UbuntuNerdFont", font->name());
+  EXPECT_TRUE(font->HasSymbol('a'));
+  EXPECT_TRUE(font->HasSymbol('b'));
+  EXPECT_FALSE(font->HasSymbol('c'));
+  EXPECT_FLOAT_EQ(59.0f, font->line_height());
+  EXPECT_FLOAT_EQ(28.0f, font->GetCharCoords('a').advance);
+  EXPECT_FLOAT_EQ(55.0f / 512.0f, font->GetCharCoords('a').x);
+}
+
+TEST(FontTest, ReportErrors) {
+  EXPECT_FALSE(Font::CreateFromFile("gl/scene/fonts/ubuntu.png"));
+  EXPECT_FALSE(Font::CreateFromFile("non_existing.fnt"));
+  EXPECT_FALSE(Font::CreateFromContents("textures ubuntu.jpg\nUbuntu 40pt\n",
+                                        "gl/scene/fonts"));
+  EXPECT_FALSE(Font::CreateFromContents("textures: missing.png\nUbuntu 40pt\n",
+                                        "gl/scene/fonts"));
+  EXPECT_FALSE(Font::CreateFromContents(
+      "textures: ubuntu.png\nUbuntu 40pt\n97\t55\t2x6\t27\t59\t1\t0\t28\t0\n",
+      "gl/scene/fonts"));
+}
+
+TEST(FontTest, DistanceField) {
+  EXPECT_FALSE(Font{"gl/scene/fonts/ubuntu.fnt"}.is_distance_field());
+  Font font{"gl/scene/fonts/ubuntu_sdf.fnt"};
+  EXPECT_TRUE(font.is_distance_field());
+  EXPECT_EQ("UbuntuNerdFontSDF", font.name());
+  EXPECT_EQ(1, font.texture().number_of_channels());
+  EXPECT_EQ(512, font.texture().width());
+  // The glyphs are the same as in the bitmap font.
+  Font bitmap_font{"gl/scene/fonts/ubuntu.fnt"};
+  EXPECT_FLOAT_EQ(bitmap_font.GetCharCoords('a').x,
+                  font.GetCharCoords('a').x);
+  EXPECT_FLOAT_EQ(bitmap_font.line_height(), font.line_height());
+}
@@ -0,0 +1,161 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#include "gl/scene/label_declutterer.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace {
+
+struct Box {
+  float min_x;
+  float min_y;
+  float max_x;
+  float max_y;
+};
+
+/// Boxes that only touch do not overlap.
+inline bool Overlap(const Box& lhs, const Box& rhs) {
+  return (lhs.min_x < rhs.max_x) & (rhs.min_x < lhs.max_x) &
+         (lhs.min_y < rhs.max_y) & (rhs.min_y < lhs.max_y);
+}
+
+/// The screen spans [-1, 1] in normalized device coordinates.
+constexpr Box kScreen{-1.0f, -1.0f, 1.0f, 1.0f};
+
+/// A label that is on the screen.
+struct Candidate {
+  Box box;
+  std::uint32_t sorted_index;
+};
+
+/// An accepted label in one of the cells it covers. The entries of a cell
+/// form a linked list that starts at the head of the cell.
+struct CellEntry {
+  std::int32_t box_index;
+  std::int32_t next_entry;
+};
+
+constexpr std::int32_t kNoEntry{-1};
+
+}  // namespace
+
+namespace gl {
+
+LabelDeclutterer::LabelDeclutterer(int grid_resolution)
+    : grid_resolution_{grid_resolution},
+      label_set_{std::make_shared<const LabelSet>()} {
+  CHECK_GT(grid_resolution_, 0) << "The grid needs at least one cell.";
+}
+
+void LabelDeclutterer::SetLabels(std::vector<Label> labels) {
+  std::vector<std::uint32_t> order(labels.size());
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [&labels](auto lhs, auto rhs) {
+    return labels[lhs].priority > labels[rhs].priority;
+  });
+  auto label_set{std::make_shared<LabelSet>()};
+  label_set->sorted_labels.reserve(labels.size());
+  for (const auto index : order) {
+    label_set->sorted_labels.push_back(labels[index]);
+  }
+  label_set->original_indices = std::move(order);
+  label_set_ = std::move(label_set);
+}
+
+std::vector<bool> LabelDeclutterer::Declutter(
+    const Eigen::Matrix4f& tf_viewport_world) const {
+  return ComputeVisibility(*label_set_, tf_viewport_world, grid_resolution_);
+}
+
+std::future<std::vector<bool>> LabelDeclutterer::DeclutterAsync(
+    const Eigen::Matrix4f& tf_viewport_world) {
+  return worker_.Enqueue([label_set = label_set_,
+                          tf_viewport_world,
+                          grid_resolution = grid_resolution_]() {
+    return ComputeVisibility(*label_set, tf_viewport_world, grid_resolution);
+  });
+}
+
+std::vector<bool> LabelDeclutterer::ComputeVisibility(
+    const LabelSet& label_set,
+    const Eigen::Matrix4f& tf_viewport_world,
+    int grid_resolution) {
+  const auto& labels{label_set.sorted_labels};
+  // Find the labels on the screen without branches, as whether a label is
+  // on the screen is hard to predict.
+  std::vector<Candidate> candidates(labels.size());
+  std::size_t number_of_candidates{};
+  for (std::size_t index = 0; index < labels.size(); ++index) {
+    const auto& label{labels[index]};
+    const Eigen::Vector4f position{tf_viewport_world *
+                                   label.anchor.homogeneous()};
+    const float inverse_w{1.0f / position.w()};
+    const float x{position.x() * inverse_w};
+    const float y{position.y() * inverse_w};
+    auto& candidate{candidates[number_of_candidates]};
+    candidate.box = {x + label.extent.min().x(),
+                     y + label.extent.min().y(),
+                     x + label.extent.max().x(),
+                     y + label.extent.max().y()};
+    candidate.sorted_index = static_cast<std::uint32_t>(index);
+    // Anchors behind the camera or beyond the far plane are not drawn.
+    const bool in_front = (position.w() > 0.0f) &
+                          (std::abs(position.z()) <= position.w());
+    number_of_candidates += in_front & Overlap(candidate.box, kScreen);
+  }
+  candidates.resize(number_of_candidates);
+
+  std::vector<bool> visible(labels.size(), false);
+  std::vector<std::int32_t> cell_heads(grid_resolution * grid_resolution,
+                                       kNoEntry);
+  std::vector<CellEntry> cell_entries{};
+  std::vector<Box> accepted_boxes{};
+  const float cells_per_unit{0.5f * grid_resolution};
+  const auto to_cell = [cells_per_unit, grid_resolution](float coordinate) {
+    const float on_screen{std::clamp(coordinate, -1.0f, 1.0f)};
+    const int cell{static_cast<int>((on_screen + 1.0f) * cells_per_unit)};
+    return std::min(cell, grid_resolution - 1);
+  };
+  for (const auto& candidate : candidates) {
+    const auto& box{candidate.box};
+    const int min_col{to_cell(box.min_x)};
+    const int max_col{to_cell(box.max_x)};
+    const int min_row{to_cell(box.min_y)};
+    const int max_row{to_cell(box.max_y)};
+    bool overlaps{false};
+    for (int row = min_row; row <= max_row && !overlaps; ++row) {
+      for (int col = min_col; col <= max_col && !overlaps; ++col) {
+        for (auto entry = cell_heads[row * grid_resolution + col];
+             entry != kNoEntry;
+             entry = cell_entries[entry].next_entry) {
+          if (Overlap(box, accepted_boxes[cell_entries[entry].box_index])) {
+            overlaps = true;
+            break;
+          }
+        }
+      }
+    }
+    if (overlaps) { continue; }
+
+    visible[label_set.original_indices[candidate.sorted_index]] = true;
+    const auto box_index{static_cast<std::int32_t>(accepted_boxes.size())};
+    accepted_boxes.push_back(box);
+    for (int row = min_row; row <= max_row; ++row) {
+      for (int col = min_col; col <= max_col; ++col) {
+        auto& head{cell_heads[row * grid_resolution + col]};
+        cell_entries.push_back({box_index, head});
+        head = static_cast<std::int32_t>(cell_entries.size() - 1ul);
+      }
+    }
+  }
+  return visible;
+}
+
+}  // namespace gl
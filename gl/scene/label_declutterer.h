@@ -0,0 +1,88 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#ifndef OPENGL_TUTORIALS_GL_SCENE_LABEL_DECLUTTERER_H_
+#define OPENGL_TUTORIALS_GL_SCENE_LABEL_DECLUTTERER_H_
+
+#include "utils/thread_pool.h"
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace gl {
+
+/// Decides which labels to show, so that labels do not overlap on the
+/// screen.
+///
+/// The anchors of the labels are projected to the screen and the labels are
+/// accepted greedily from the highest priority down. A label is hidden if it
+/// overlaps an already accepted label, is off the screen or is behind the
+/// camera. The accepted labels are stored in a uniform grid over the screen,
+/// so that every label is only compared to the accepted labels in the cells
+/// it covers.
+class LabelDeclutterer {
+ public:
+  struct Label {
+    /// Position of the label in the world.
+    Eigen::Vector3f anchor{Eigen::Vector3f::Zero()};
+    /// Extent of the label around its projected anchor in normalized device
+    /// coordinates.
+    Eigen::AlignedBox2f extent{};
+    /// Labels with higher priority are shown first.
+    float priority{};
+  };
+
+  static constexpr int kDefaultGridResolution{64};
+
+  /// The grid has grid_resolution cells along each side of the screen.
+  explicit LabelDeclutterer(int grid_resolution = kDefaultGridResolution);
+  LabelDeclutterer(const LabelDeclutterer&) = delete;
+  LabelDeclutterer& operator=(const LabelDeclutterer&) = delete;
+
+  /// Replace all labels. The labels are sorted by their priority here, so
+  /// that every frame only needs to project them.
+  void SetLabels(std::vector<Label> labels);
+
+  /// Find the labels that are visible from the camera. The result holds a
+  /// flag for every label in the order the labels were set.
+  std::vector<bool> Declutter(const Eigen::Matrix4f& tf_viewport_world) const;
+
+  /// Same as Declutter but runs on a worker thread, e.g., while the previous
+  /// frame is drawn. Changing the labels does not affect running requests.
+  std::future<std::vector<bool>> DeclutterAsync(
+      const Eigen::Matrix4f& tf_viewport_world);
+
+  std::size_t number_of_labels() const noexcept {
+    return label_set_->sorted_labels.size();
+  }
+
+ private:
+  struct LabelSet {
+    /// Labels sorted by priority, the highest first, so that every frame
+    /// reads them in order.
+    std::vector<Label> sorted_labels{};
+    /// Index of every sorted label in the order the labels were set.
+    std::vector<std::uint32_t> original_indices{};
+  };
+
+  static std::vector<bool> ComputeVisibility(
+      const LabelSet& label_set,
+      const Eigen::Matrix4f& tf_viewport_world,
+      int grid_resolution);
+
+  int grid_resolution_{};
+  std::shared_ptr<const LabelSet> label_set_{};
+  /// Declared last to finish running requests before the members they use
+  /// are destroyed.
+  utils::ThreadPool worker_{1ul};
+};
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_GL_SCENE_LABEL_DECLUTTERER_H_
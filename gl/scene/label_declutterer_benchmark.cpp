@@ -0,0 +1,61 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+// Measures how long it takes to declutter many labels scattered around the
+// default camera of the viewer.
+
+#include "gl/scene/label_declutterer.h"
+#include "gl/utils/camera.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kNumberOfLabels{100000};
+constexpr int kRepetitions{50};
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<gl::LabelDeclutterer::Label> GenerateLabels() {
+  std::mt19937 generator{42u};
+  std::uniform_real_distribution<float> position{-20.0f, 20.0f};
+  std::uniform_real_distribution<float> width{0.05f, 0.3f};
+  std::uniform_real_distribution<float> priority{0.0f, 1.0f};
+  std::vector<gl::LabelDeclutterer::Label> labels(kNumberOfLabels);
+  for (auto& label : labels) {
+    label.anchor = {
+        position(generator), position(generator), position(generator)};
+    label.extent = {Eigen::Vector2f{0.0f, 0.0f},
+                    Eigen::Vector2f{width(generator), 0.05f}};
+    label.priority = priority(generator);
+  }
+  return labels;
+}
+
+}  // namespace
+
+int main() {
+  gl::LabelDeclutterer declutterer{};
+  declutterer.SetLabels(GenerateLabels());
+  gl::Camera camera{30.0f};
+  const Eigen::Matrix4f tf_viewport_world{camera.TfViewportWorld()};
+
+  std::size_t number_of_visible_labels{};
+  const auto start{Clock::now()};
+  for (int repetition = 0; repetition < kRepetitions; ++repetition) {
+    for (const bool visible : declutterer.Declutter(tf_viewport_world)) {
+      number_of_visible_labels += visible;
+    }
+  }
+  const std::chrono::duration<double, std::milli> duration{Clock::now() -
+                                                           start};
+  std::printf("%d labels: %.3f ms per frame, %zu visible\n",
+              kNumberOfLabels,
+              duration.count() / kRepetitions,
+              number_of_visible_labels / kRepetitions);
+  return 0;
+}
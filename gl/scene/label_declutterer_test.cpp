@@ -0,0 +1,109 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#include "gl/scene/label_declutterer.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using gl::LabelDeclutterer;
+
+namespace {
+
+LabelDeclutterer::Label CreateLabel(float x, float y, float priority) {
+  return {{x, y, 0.0f},
+          {Eigen::Vector2f{0.0f, 0.0f}, Eigen::Vector2f{0.25f, 0.125f}},
+          priority};
+}
+
+}  // namespace
+
+TEST(LabelDecluttererTest, HigherPriorityWins) {
+  LabelDeclutterer declutterer{};
+  declutterer.SetLabels({CreateLabel(0.0f, 0.0f, 1.0f),
+                         CreateLabel(0.125f, 0.0625f, 2.0f),
+                         CreateLabel(0.5f, 0.5f, 0.0f),
+                         // Touches the second label but does not overlap it.
+                         CreateLabel(0.375f, 0.0625f, 3.0f)});
+  EXPECT_EQ(4ul, declutterer.number_of_labels());
+  const std::vector<bool> expected{false, true, true, true};
+  EXPECT_EQ(expected, declutterer.Declutter(Eigen::Matrix4f::Identity()));
+}
+
+TEST(LabelDecluttererTest, HideLabelsOutsideOfView) {
+  // Project with w equal to z, so that negative z is behind the camera.
+  Eigen::Matrix4f tf_viewport_world{Eigen::Matrix4f::Zero()};
+  tf_viewport_world(0, 0) = 1.0f;
+  tf_viewport_world(1, 1) = 1.0f;
+  tf_viewport_world(3, 2) = 1.0f;
+  LabelDeclutterer declutterer{};
+  auto behind_camera{CreateLabel(0.0f, 0.0f, 1.0f)};
+  behind_camera.anchor.z() = -1.0f;
+  auto in_view{CreateLabel(1.0f, 1.0f, 0.0f)};
+  in_view.anchor.z() = 2.0f;
+  auto off_screen{CreateLabel(4.0f, 0.0f, 0.0f)};
+  off_screen.anchor.z() = 2.0f;
+  declutterer.SetLabels({behind_camera, in_view, off_screen});
+  const std::vector<bool> expected{false, true, false};
+  EXPECT_EQ(expected, declutterer.Declutter(tf_viewport_world));
+}
+
+TEST(LabelDecluttererTest, MatchBruteForce) {
+  std::mt19937 generator{42u};
+  std::uniform_real_distribution<float> position{-1.2f, 1.2f};
+  std::uniform_real_distribution<float> size{0.01f, 0.3f};
+  std::vector<LabelDeclutterer::Label> labels(2000);
+  for (auto& label : labels) {
+    label.anchor = {position(generator), position(generator), 0.0f};
+    label.extent = {Eigen::Vector2f{-size(generator), 0.0f},
+                    Eigen::Vector2f{size(generator), size(generator)}};
+    label.priority = position(generator);
+  }
+  LabelDeclutterer declutterer{16};
+  declutterer.SetLabels(labels);
+  const auto visible{declutterer.Declutter(Eigen::Matrix4f::Identity())};
+
+  const auto overlap = [](const Eigen::AlignedBox2f& lhs,
+                          const Eigen::AlignedBox2f& rhs) {
+    return (lhs.min().array() < rhs.max().array()).all() &&
+           (rhs.min().array() < lhs.max().array()).all();
+  };
+  const auto box = [](const LabelDeclutterer::Label& label) {
+    return label.extent.translated(label.anchor.head<2>());
+  };
+  const Eigen::AlignedBox2f screen{Eigen::Vector2f{-1.0f, -1.0f},
+                                   Eigen::Vector2f{1.0f, 1.0f}};
+  for (std::size_t i = 0; i < labels.size(); ++i) {
+    if (!overlap(box(labels[i]), screen)) {
+      EXPECT_FALSE(visible[i]);
+      continue;
+    }
+    // A label is hidden if and only if it overlaps a shown label with a
+    // higher priority.
+    bool hidden_by_other{false};
+    for (std::size_t j = 0; j < labels.size(); ++j) {
+      if (i == j || !visible[j]) { continue; }
+      if (labels[j].priority < labels[i].priority) { continue; }
+      if (overlap(box(labels[i]), box(labels[j]))) {
+        hidden_by_other = true;
+        break;
+      }
+    }
+    EXPECT_NE(hidden_by_other, visible[i]) << "Label " << i;
+  }
+}
+
+TEST(LabelDecluttererTest, DeclutterAsync) {
+  LabelDeclutterer declutterer{};
+  declutterer.SetLabels(
+      {CreateLabel(0.0f, 0.0f, 1.0f), CreateLabel(0.0f, 0.0f, 2.0f)});
+  auto visible{declutterer.DeclutterAsync(Eigen::Matrix4f::Identity())};
+  // Running requests keep using the labels they started with.
+  declutterer.SetLabels({CreateLabel(0.0f, 0.0f, 1.0f)});
+  const std::vector<bool> expected{false, true};
+  EXPECT_EQ(expected, visible.get());
+  EXPECT_EQ(std::vector<bool>{true},
+            declutterer.DeclutterAsync(Eigen::Matrix4f::Identity()).get());
+}
@@ -0,0 +1,82 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+// Convert a bitmap font into a font that stores a signed distance field of its
+// glyphs. The glyph positions stay the same, only the texture is replaced by a
+// single channel *.pgm image next to the new font file.
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "gl/scene/font.h"
+#include "utils/distance_field.h"
+#include "utils/file_utils.h"
+
+#include "glog/logging.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+ABSL_FLAG(std::string, font, "gl/scene/fonts/ubuntu.fnt", "Bitmap font.");
+ABSL_FLAG(std::string,
+          output,
+          "gl/scene/fonts/ubuntu_sdf.fnt",
+          "Where to write the distance field font.");
+ABSL_FLAG(float,
+          spread,
+          8.0f,
+          "Distance to the glyph edge in pixels that maps to 0 or 255.");
+
+int main(int argc, char* argv[]) {
+  absl::ParseCommandLine(argc, argv);
+  google::InitGoogleLogging(argv[0]);
+
+  const auto font_path{absl::GetFlag(FLAGS_font)};
+  const auto font{gl::Font::CreateFromFile(font_path)};
+  if (!font) { return EXIT_FAILURE; }
+  const auto& image{font->texture()};
+  // Glyphs are stored in the alpha channel if there is one.
+  const int channel{image.number_of_channels() % 2 == 0
+                        ? image.number_of_channels() - 1
+                        : 0};
+  const auto field{utils::ComputeSignedDistanceField(
+      image, channel, absl::GetFlag(FLAGS_spread))};
+  if (!field) {
+    LOG(ERROR) << "Cannot compute a distance field of the font texture.";
+    return EXIT_FAILURE;
+  }
+
+  const std::filesystem::path output_path{absl::GetFlag(FLAGS_output)};
+  auto image_path{output_path};
+  image_path.replace_extension(".pgm");
+  if (!field->WritePnm(image_path)) {
+    LOG(ERROR) << "Cannot write " << image_path;
+    return EXIT_FAILURE;
+  }
+
+  // Keep the glyphs of the original font, but point to the new texture and
+  // add a suffix to the name, so that both fonts can be loaded together. The
+  // name line ends with the size of the font.
+  const auto contents{utils::ReadFileContents(font_path)};
+  if (!contents) { return EXIT_FAILURE; }
+  const auto end_of_texture_line{contents->find('\n')};
+  const auto end_of_name_line{contents->find('\n', end_of_texture_line + 1ul)};
+  const auto size_start{contents->find_last_of(" \t", end_of_name_line)};
+  if (end_of_name_line == std::string::npos ||
+      size_start <= end_of_texture_line) {
+    LOG(ERROR) << "Wrong format of " << font_path;
+    return EXIT_FAILURE;
+  }
+  std::ofstream output{output_path};
+  output << "textures: " << image_path.filename().string() << '\n'
+         << contents->substr(end_of_texture_line + 1ul,
+                             size_start - end_of_texture_line - 1ul)
+         << " SDF" << contents->substr(size_start);
+  if (!output) {
+    LOG(ERROR) << "Cannot write " << output_path;
+    return EXIT_FAILURE;
+  }
+  LOG(INFO) << "Wrote " << output_path << " and " << image_path;
+  return EXIT_SUCCESS;
+}
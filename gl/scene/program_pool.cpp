@@ -28,6 +28,29 @@ void ProgramPool::UseProgram(ProgramIndex program_index) noexcept {
   CHECK(program.has_value()) << "Trying to use a deleted program.";
   active_program_index_ = program_index;
   program->Use();
+  program->CommitPendingUniforms();
+}
+
+bool ProgramPool::BindShaderStorageBlock(ProgramIndex program_index,
+                                         const std::string& block_name,
+                                         GLuint binding_index) const noexcept {
+  CHECK_LT(program_index, programs_.size())
+      << "Trying to use a program by a wrong program index.";
+  const auto& program{programs_[program_index]};
+  CHECK(program.has_value()) << "Trying to use a deleted program.";
+  return program->BindShaderStorageBlock(block_name, binding_index);
+}
+
+int ProgramPool::BindShaderStorageBlockInAllPrograms(
+    const std::string& block_name, GLuint binding_index) const noexcept {
+  int number_of_bound_blocks{};
+  for (const auto& program : programs_) {
+    if (!program) { continue; }
+    if (program->BindShaderStorageBlock(block_name, binding_index)) {
+      ++number_of_bound_blocks;
+    }
+  }
+  return number_of_bound_blocks;
 }
 
 void ProgramPool::RemoveProgram(ProgramIndex program_index) noexcept {
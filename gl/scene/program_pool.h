@@ -43,7 +43,7 @@ class ProgramPool {
   /// behavior is undefined.
   void RemoveProgram(ProgramIndex program_index) noexcept;
 
-  /// Use the program.
+  /// Use the program. This also sends all pending uniform values of it.
   void UseProgram(ProgramIndex program_index) noexcept;
 
   template <typename... Ts>
@@ -65,26 +65,62 @@ class ProgramPool {
     return program->GetUniform(uniform_index).UpdateValue(numbers...);
   }
 
+  /// Set a uniform of a given program.
+  ///
+  /// The value is only recorded here. It is sent to OpenGL when the program is
+  /// used next time and only if it differs from the value sent previously, so
+  /// setting the same uniform many times per frame costs a single GL call.
+  template <typename... Ts>
+  [[nodiscard]] inline std::size_t SetUniform(ProgramIndex program_index,
+                                              const std::string& uniform_name,
+                                              const Ts&... numbers) {
+    return GetProgram(program_index).StageUniform(uniform_name, numbers...);
+  }
+
+  /// Use this version when the uniform index is already known.
+  template <typename... Ts>
+  inline void UpdateUniform(ProgramIndex program_index,
+                            std::size_t uniform_index,
+                            const Ts&... numbers) {
+    GetProgram(program_index).StageUniformUpdate(uniform_index, numbers...);
+  }
+
+  /// Set a uniform in all programs. The values are sent when each of the
+  /// programs is used next time.
   template <typename... Ts>
   inline void SetUniformToAllPrograms(const std::string& uniform_name,
                                       const Ts&... numbers) {
-    const auto prev_active_program_index = active_program_index_;
-    std::size_t program_index{};
-    for (auto& program : programs_) {
-      UseProgram(program_index++);
-      (void)program->SetUniform(uniform_name, numbers...);
-    }
-    if (prev_active_program_index) {
-      UseProgram(prev_active_program_index.value());
+    for (ProgramIndex index = 0; index < programs_.size(); ++index) {
+      if (!programs_[index]) { continue; }
+      (void)SetUniform(index, uniform_name, numbers...);
     }
   }
 
+  /// Connect a shader storage block of a program to an indexed binding point.
+  /// Returns false if the program has no block with this name.
+  bool BindShaderStorageBlock(ProgramIndex program_index,
+                              const std::string& block_name,
+                              GLuint binding_index) const noexcept;
+
+  /// Connect a shader storage block to a binding point in all programs that
+  /// have it. Returns the number of programs that have such a block.
+  int BindShaderStorageBlockInAllPrograms(const std::string& block_name,
+                                          GLuint binding_index) const noexcept;
+
   [[nodiscard]] inline std::optional<ProgramIndex> active_program_index()
       const noexcept {
     return active_program_index_;
   }
 
  private:
+  inline Program& GetProgram(ProgramIndex program_index) noexcept {
+    CHECK_LT(program_index, programs_.size())
+        << "Trying to use a program by a wrong program index.";
+    auto& program{programs_[program_index]};
+    CHECK(program.has_value()) << "Trying to use a deleted program.";
+    return program.value();
+  }
+
   std::vector<std::optional<Program>> programs_;
   std::optional<ProgramIndex> active_program_index_;
 };
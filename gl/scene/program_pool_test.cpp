@@ -3,6 +3,7 @@
 // Email: <name>.<family_name>@gmail.com.
 
 #include "gl/scene/program_pool.h"
+#include "gl/utils/eigen_traits.h"
 #include "gtest/gtest.h"
 
 using gl::ProgramPool;
@@ -22,4 +23,57 @@ TEST(ProgramPoolTest, Simple) {
   ASSERT_EQ(another_points_program_index.value(), 1UL);
 }
 
+TEST(ProgramPoolTest, BindMissingShaderStorageBlock) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/points.vert", "gl/scene/shaders/simple.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  EXPECT_FALSE(
+      pool.BindShaderStorageBlock(program_index.value(), "PointLabels", 0u));
+  EXPECT_EQ(0, pool.BindShaderStorageBlockInAllPrograms("PointLabels", 0u));
+}
+
+TEST(ProgramPoolTest, SetUniformWithoutSwitchingPrograms) {
+  ProgramPool pool{};
+  const auto first_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/points.vert", "gl/scene/shaders/simple.frag"}))};
+  ASSERT_TRUE(first_index.has_value());
+  const auto second_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/points.vert", "gl/scene/shaders/simple.frag"}))};
+  ASSERT_TRUE(second_index.has_value());
+  pool.UseProgram(first_index.value());
+  const auto uniform_index{pool.SetUniform(
+      second_index.value(), "color", Eigen::Vector3f{1.0F, 0.5F, 0.0F})};
+  pool.UpdateUniform(
+      second_index.value(), uniform_index, Eigen::Vector3f{0.0F, 1.0F, 0.0F});
+  ASSERT_TRUE(pool.active_program_index().has_value());
+  EXPECT_EQ(pool.active_program_index().value(), first_index.value());
+  pool.SetUniformToAllPrograms("proj_view", Eigen::Matrix4f::Identity());
+  EXPECT_EQ(pool.active_program_index().value(), first_index.value());
+}
+
+TEST(ProgramPoolTest, UniformsAreCommittedWhenProgramIsUsed) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/points.vert", "gl/scene/shaders/simple.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  pool.UseProgram(program_index.value());
+  GLint program_id{};
+  glGetIntegerv(GL_CURRENT_PROGRAM, &program_id);
+  const auto location{glGetUniformLocation(program_id, "color")};
+  ASSERT_GE(location, 0);
+  const auto uniform_index{pool.SetUniform(
+      program_index.value(), "color", Eigen::Vector3f{1.0F, 0.0F, 0.0F})};
+  pool.UpdateUniform(
+      program_index.value(), uniform_index, Eigen::Vector3f{0.0F, 1.0F, 0.0F});
+  GLfloat color[3]{};
+  glGetUniformfv(program_id, location, color);
+  EXPECT_FLOAT_EQ(color[1], 0.0F);
+  pool.UseProgram(program_index.value());
+  glGetUniformfv(program_id, location, color);
+  EXPECT_FLOAT_EQ(color[0], 0.0F);
+  EXPECT_FLOAT_EQ(color[1], 1.0F);
+  EXPECT_FLOAT_EQ(color[2], 0.0F);
+}
+
 // TODO(igor): add more tests here
@@ -15,27 +15,27 @@ SceneGraph::Key SceneGraph::GenerateNextKey() { return global_node_counter_++; }
 
 SceneGraph::SceneGraph() {}
 
-SceneGraph::Node& SceneGraph::GetNode(Key key) {
-  CHECK_GT(storage_.count(key), 0u);
-  return *storage_.at(key);
+SceneGraph::Node SceneGraph::GetNode(Key key) {
+  return Node{this, FindHandle(key)};
 }
-const SceneGraph::Node& SceneGraph::GetNode(Key key) const {
-  CHECK_GT(storage_.count(key), 0u);
-  return *storage_.at(key);
+const SceneGraph::Node SceneGraph::GetNode(Key key) const {
+  // The returned node is const, so it only allows reading the graph. The
+  // cached world transformations are still updated when they are read.
+  return Node{const_cast<SceneGraph*>(this), FindHandle(key)};
 }
 
 SceneGraph::Key SceneGraph::RegisterBranchKey(Key key) {
   std::lock_guard<std::recursive_mutex> guard(graph_mutex);
-  if (storage_.count(key) > 0) {
+  if (handles_.count(key) > 0) {
     LOG(WARNING) << "Key " << key << " already registered in scene graph.";
     return false;
   }
-  // Our root is a null drawable that has base key as the parent.
-  auto branch_root = std::make_unique<Node>(
-      key, kRootKey, nullptr, Eigen::Isometry3f::Identity(), &storage_);
-
-  // Add it to storage.
-  storage_.emplace(key, std::move(branch_root));
+  // Our root is a null drawable that has no parent.
+  const auto index{AllocateNode()};
+  keys_[index] = key;
+  tfs_parent_from_local_[index] = Eigen::Isometry3f::Identity();
+  handles_.emplace(key, Handle{index, generations_[index]});
+  depth_first_order_stale_ = true;
   return key;
 }
 
@@ -45,105 +45,263 @@ SceneGraph::Key SceneGraph::Attach(
     const Eigen::Isometry3f& tf_parent_from_local,
     Key new_key) {
   std::lock_guard<decltype(graph_mutex)> guard(graph_mutex);
-  CHECK_GT(storage_.count(parent_key), 0u) << "New node must have a parent";
-  storage_.emplace(
-      new_key,
-      std::make_unique<Node>(
-          new_key, parent_key, drawable, tf_parent_from_local, &storage_));
-  storage_.at(parent_key)->AddChildKey(new_key);
+  CHECK_GT(handles_.count(parent_key), 0u) << "New node must have a parent";
+  CHECK_EQ(handles_.count(new_key), 0u) << "Key " << new_key << " is taken";
+  const auto parent{handles_.at(parent_key).index};
+  const auto index{AllocateNode()};
+  keys_[index] = new_key;
+  tfs_parent_from_local_[index] = tf_parent_from_local;
+  drawables_[index] = std::move(drawable);
+  LinkToParent(index, parent);
+  handles_.emplace(new_key, Handle{index, generations_[index]});
+  depth_first_order_stale_ = true;
   return new_key;
 }
 
-int SceneGraph::Erase(Key key) { return NodeEraser{&storage_}.Erase(key); }
+int SceneGraph::Erase(Key key) {
+  std::lock_guard<decltype(graph_mutex)> guard(graph_mutex);
+  if (handles_.count(key) < 1) { return 0; }
+  const auto index{handles_.at(key).index};
+  UnlinkFromParent(index);
+  return EraseSubtree(index);
+}
 
 int SceneGraph::EraseChildren(Key key) {
-  return NodeEraser{&storage_}.EraseChildren(key);
+  std::lock_guard<decltype(graph_mutex)> guard(graph_mutex);
+  const auto index{FindHandle(key).index};
+  int erased_nodes_count{};
+  for (auto child = first_children_[index]; child != kNoIndex;) {
+    const auto next_child{next_siblings_[child]};
+    erased_nodes_count += EraseSubtree(child);
+    child = next_child;
+  }
+  first_children_[index] = kNoIndex;
+  last_children_[index] = kNoIndex;
+  return erased_nodes_count;
 }
 
 void SceneGraph::Draw(Key key) {
   std::lock_guard<decltype(graph_mutex)> guard(graph_mutex);
-  CHECK_GT(storage_.count(key), 0u);
-  GetNode(key).Draw();
-}
-
-SceneGraph::Node::Node(SceneGraph::Key node_key,
-                       SceneGraph::Key parent_key,
-                       Drawable::SharedPtr drawable,
-                       const Eigen::Isometry3f& tf_parent_from_local,
-                       SceneGraph::Storage<UniquePtr>* storage)
-    : key_{node_key},
-      parent_key_{parent_key},
-      tf_parent_from_local_{tf_parent_from_local},
-      drawable_{drawable},
-      storage_{storage} {
-  CHECK_NOTNULL(storage_);
-}
-
-void SceneGraph::Node::Draw(
-    const Eigen::Isometry3f& tf_world_from_parent) const {
-  CHECK_NOTNULL(storage_);
-  Eigen::Isometry3f tf_world_from_local =
-      tf_world_from_parent * tf_parent_from_local_;
-  if (drawable_) {
-    if (!drawable_->ready_to_draw()) { drawable_->FillBuffers(); }
-    drawable_->SetModel(tf_world_from_local.matrix());
-    drawable_->Draw();
+  const auto root{FindHandle(key).index};
+  if (depth_first_order_stale_) { UpdateDepthFirstOrder(); }
+  // Brings the parents of the branch up to date, so that every node in the
+  // branch only needs its parent that comes before it.
+  ComputeTfWorldFromLocal(root);
+  const auto begin{depth_first_positions_[root]};
+  const auto end{depth_first_ends_[root]};
+  for (auto position = begin; position < end; ++position) {
+    const auto index{depth_first_order_[position]};
+    if (flags_[index] & kTfWorldFromLocalStale) {
+      DCHECK_NE(parents_[index], kNoIndex);
+      DCHECK(!(flags_[parents_[index]] & kTfWorldFromLocalStale));
+      tfs_world_from_local_[index] = tfs_world_from_local_[parents_[index]] *
+                                     tfs_parent_from_local_[index];
+      flags_[index] &= ~kTfWorldFromLocalStale;
+    }
+    const auto& drawable{drawables_[index]};
+    if (!drawable) { continue; }
+    if (!drawable->ready_to_draw()) { drawable->FillBuffers(); }
+    drawable->SetModel(tfs_world_from_local_[index].matrix());
+    drawable->Draw();
   }
-  for (const auto& child_key : children_keys_) {
-    DCHECK_GT(storage_->count(child_key), 0u);
-    const auto& child = storage_->at(child_key);
-    child->Draw(tf_world_from_local);
+}
+
+SceneGraph::Handle SceneGraph::FindHandle(Key key) const {
+  CHECK_GT(handles_.count(key), 0u);
+  return handles_.at(key);
+}
+
+SceneGraph::Index SceneGraph::AllocateNode() {
+  Index index{};
+  if (free_indices_.empty()) {
+    index = static_cast<Index>(keys_.size());
+    CHECK_LT(index, kNoIndex) << "Too many nodes in the graph.";
+    keys_.emplace_back();
+    generations_.emplace_back();
+    flags_.emplace_back();
+    parents_.emplace_back();
+    first_children_.emplace_back();
+    last_children_.emplace_back();
+    next_siblings_.emplace_back();
+    previous_siblings_.emplace_back();
+    tfs_parent_from_local_.emplace_back();
+    tfs_world_from_local_.emplace_back();
+    drawables_.emplace_back();
+    depth_first_positions_.emplace_back();
+    depth_first_ends_.emplace_back();
+  } else {
+    index = free_indices_.back();
+    free_indices_.pop_back();
   }
+  flags_[index] = kAlive | kTfWorldFromLocalStale;
+  parents_[index] = kNoIndex;
+  first_children_[index] = kNoIndex;
+  last_children_[index] = kNoIndex;
+  next_siblings_[index] = kNoIndex;
+  previous_siblings_[index] = kNoIndex;
+  return index;
 }
 
-Eigen::Isometry3f SceneGraph::Node::ComputeTfWorldFromLocal() const {
-  CHECK_NOTNULL(storage_);
-  Eigen::Isometry3f tf_current_parent_from_local = tf_parent_from_local_;
-  Key parent_key = parent_key_;
-  while (parent_key != kRootKey) {
-    DCHECK_GT(storage_->count(parent_key), static_cast<size_t>(0));
-    auto& parent_node = storage_->at(parent_key);
-    tf_current_parent_from_local =
-        parent_node->tf_parent_from_local() * tf_current_parent_from_local;
-    parent_key = parent_node->parent_key();
+void SceneGraph::LinkToParent(Index index, Index parent) {
+  parents_[index] = parent;
+  previous_siblings_[index] = last_children_[parent];
+  if (last_children_[parent] == kNoIndex) {
+    first_children_[parent] = index;
+  } else {
+    next_siblings_[last_children_[parent]] = index;
   }
-  return tf_current_parent_from_local;
-}
-
-SceneGraph::NodeEraser::NodeEraser(
-    SceneGraph::Storage<Node::UniquePtr>* storage)
-    : storage_{storage} {}
-
-int SceneGraph::NodeEraser::EraseChildren(Key key) {
-  CHECK_NOTNULL(storage_);
-  CHECK_GT(storage_->count(key), 0u);
-  std::set<Key> children{};
-  FindRecursiveChildren(key, &children);
-  for (auto child_key : children) { storage_->erase(child_key); }
-  auto& node{storage_->at(key)};
-  node->ClearChildKeys();
-  return static_cast<int>(children.size());
-}
-
-int SceneGraph::NodeEraser::Erase(Key key) {
-  CHECK_NOTNULL(storage_);
-  if (storage_->count(key) < 1) { return 0; }
-  const auto erased_nodes_count{EraseChildren(key)};
-  const auto& node{storage_->at(key)};
-  auto& parent_node{storage_->at(node->parent_key())};
-  parent_node->EraseChildKey(key);
-  storage_->erase(key);
-  return erased_nodes_count + 1;
-}
-
-void SceneGraph::NodeEraser::FindRecursiveChildren(Key key,
-                                                   std::set<Key>* children) {
-  const auto& node{storage_->at(key)};
-  const auto& current_children_keys{node->children_keys()};
-  for (auto key : current_children_keys) {
-    children->insert(key);
-    FindRecursiveChildren(key, children);
+  last_children_[parent] = index;
+}
+
+void SceneGraph::UnlinkFromParent(Index index) {
+  const auto parent{parents_[index]};
+  if (parent == kNoIndex) { return; }
+  const auto previous{previous_siblings_[index]};
+  const auto next{next_siblings_[index]};
+  if (previous == kNoIndex) {
+    first_children_[parent] = next;
+  } else {
+    next_siblings_[previous] = next;
   }
+  if (next == kNoIndex) {
+    last_children_[parent] = previous;
+  } else {
+    previous_siblings_[next] = previous;
+  }
+  parents_[index] = kNoIndex;
+}
+
+int SceneGraph::EraseSubtree(Index index) {
+  int erased_nodes_count{};
+  std::vector<Index> indices_to_erase{index};
+  while (!indices_to_erase.empty()) {
+    const auto current{indices_to_erase.back()};
+    indices_to_erase.pop_back();
+    for (auto child = first_children_[current]; child != kNoIndex;
+         child = next_siblings_[child]) {
+      indices_to_erase.push_back(child);
+    }
+    handles_.erase(keys_[current]);
+    drawables_[current].reset();
+    flags_[current] = 0u;
+    ++generations_[current];
+    free_indices_.push_back(current);
+    ++erased_nodes_count;
+  }
+  depth_first_order_stale_ = true;
+  return erased_nodes_count;
+}
+
+void SceneGraph::InvalidateTfWorldFromLocal(Index index) {
+  std::vector<Index> indices_to_invalidate{index};
+  while (!indices_to_invalidate.empty()) {
+    const auto current{indices_to_invalidate.back()};
+    indices_to_invalidate.pop_back();
+    if (flags_[current] & kTfWorldFromLocalStale) { continue; }
+    flags_[current] |= kTfWorldFromLocalStale;
+    for (auto child = first_children_[current]; child != kNoIndex;
+         child = next_siblings_[child]) {
+      indices_to_invalidate.push_back(child);
+    }
+  }
+}
+
+const Eigen::Isometry3f& SceneGraph::ComputeTfWorldFromLocal(Index index) {
+  auto& tf_world_from_local{tfs_world_from_local_[index]};
+  if (!(flags_[index] & kTfWorldFromLocalStale)) { return tf_world_from_local; }
+  const auto parent{parents_[index]};
+  if (parent == kNoIndex) {
+    tf_world_from_local = tfs_parent_from_local_[index];
+  } else {
+    tf_world_from_local =
+        ComputeTfWorldFromLocal(parent) * tfs_parent_from_local_[index];
+  }
+  flags_[index] &= ~kTfWorldFromLocalStale;
+  return tf_world_from_local;
+}
+
+void SceneGraph::UpdateDepthFirstOrder() {
+  depth_first_order_.clear();
+  depth_first_order_.reserve(handles_.size());
+  for (Index root = 0; root < keys_.size(); ++root) {
+    if (!(flags_[root] & kAlive) || parents_[root] != kNoIndex) { continue; }
+    // Walk the branch without recursion, closing the ranges of the nodes
+    // whose children are all visited.
+    auto index{root};
+    bool branch_done{false};
+    while (!branch_done) {
+      depth_first_positions_[index] =
+          static_cast<Index>(depth_first_order_.size());
+      depth_first_order_.push_back(index);
+      if (first_children_[index] != kNoIndex) {
+        index = first_children_[index];
+        continue;
+      }
+      while (true) {
+        depth_first_ends_[index] =
+            static_cast<Index>(depth_first_order_.size());
+        if (index == root) {
+          branch_done = true;
+          break;
+        }
+        if (next_siblings_[index] != kNoIndex) {
+          index = next_siblings_[index];
+          break;
+        }
+        index = parents_[index];
+      }
+    }
+  }
+  depth_first_order_stale_ = false;
+}
+
+SceneGraph::Node::Node(SceneGraph* graph, Handle handle)
+    : graph_{graph}, handle_{handle} {
+  CHECK_NOTNULL(graph_);
+}
+
+SceneGraph::Index SceneGraph::Node::index() const {
+  CHECK_EQ(graph_->generations_[handle_.index], handle_.generation)
+      << "The node was erased from the graph.";
+  return handle_.index;
+}
+
+SceneGraph::Key SceneGraph::Node::key() const {
+  return graph_->keys_[index()];
+}
+
+SceneGraph::Key SceneGraph::Node::parent_key() const {
+  const auto parent{graph_->parents_[index()]};
+  if (parent == kNoIndex) { return kRootKey; }
+  return graph_->keys_[parent];
+}
+
+std::vector<SceneGraph::Key> SceneGraph::Node::children_keys() const {
+  std::vector<Key> children_keys{};
+  for (auto child = graph_->first_children_[index()]; child != kNoIndex;
+       child = graph_->next_siblings_[child]) {
+    children_keys.push_back(graph_->keys_[child]);
+  }
+  return children_keys;
+}
+
+Drawable::SharedPtr SceneGraph::Node::drawable() const {
+  return graph_->drawables_[index()];
+}
+
+Eigen::Isometry3f SceneGraph::Node::tf_parent_from_local() const {
+  return graph_->tfs_parent_from_local_[index()];
+}
+
+void SceneGraph::Node::set_tf_parent_from_local(
+    const Eigen::Isometry3f& tf_parent_from_local) {
+  const auto node_index{index()};
+  graph_->tfs_parent_from_local_[node_index] = tf_parent_from_local;
+  graph_->InvalidateTfWorldFromLocal(node_index);
+}
+
+Eigen::Isometry3f SceneGraph::Node::ComputeTfWorldFromLocal() const {
+  return graph_->ComputeTfWorldFromLocal(index());
 }
 
 }  // namespace gl
@@ -6,33 +6,83 @@
 #define OPENGL_TUTORIALS_GL_SCENE_SCENE_GRAPH_H_
 
 #include "gl/scene/drawables/drawable.h"
+#include "utils/eigen_utils.h"
 
 #include <Eigen/Geometry>
 
-#include <map>
+#include <cstdint>
+#include <limits>
 #include <mutex>
-#include <set>
 #include <unordered_map>
+#include <vector>
 
 namespace gl {
 
 /// A scene graph class where all drawables are organized into a tree where the
 /// edges hold the relative transformation information.
+///
+/// The nodes are stored as a structure of arrays and refer to each other by
+/// their indices in these arrays. The public keys are only used to find a
+/// node. The graph keeps its nodes in depth-first order, so that drawing a
+/// branch is a linear scan over it.
 class SceneGraph {
-  class Node;  // Forward declare.
-
  public:
   using Key = uint64_t;
 
-  template <class T>
-  using Storage = std::unordered_map<Key, T>;
-
   template <class T>
   struct NodeData {
     Key key;
     T data;
   };
 
+ private:
+  using Index = std::uint32_t;
+
+  /// Points to a slot of the node arrays. The slots of erased nodes are reused
+  /// with a new generation, so a handle to an erased node never points to a
+  /// node that took its place.
+  struct Handle {
+    Index index;
+    std::uint32_t generation;
+  };
+
+ public:
+  /// A view of a single node of the graph. It stays valid until the node is
+  /// erased. It returns copies of the node data, as the node arrays move in
+  /// memory when nodes are attached.
+  class Node {
+   public:
+    Key key() const;
+    Key parent_key() const;
+    /// Keys of the direct children of this node in the order they were
+    /// attached.
+    std::vector<Key> children_keys() const;
+
+    Drawable::SharedPtr drawable() const;
+
+    Eigen::Isometry3f tf_parent_from_local() const;
+    /// Move this node relative to its parent. This invalidates the cached
+    /// world transformations of the node and all of its children.
+    void set_tf_parent_from_local(
+        const Eigen::Isometry3f& tf_parent_from_local);
+
+    /// Get the transformation from this node to the world. It is cached and
+    /// only recomputed from the parent's one if this node or any of its
+    /// parents moved since the last call.
+    Eigen::Isometry3f ComputeTfWorldFromLocal() const;
+
+   private:
+    friend class SceneGraph;
+    Node(SceneGraph* graph, Handle handle);
+
+    /// Index of the node, checked to belong to the node this view was made
+    /// for.
+    Index index() const;
+
+    SceneGraph* graph_{};
+    Handle handle_{};
+  };
+
   SceneGraph();
 
   /// Register a key that will be a root of a branch. Example: world, odometry,
@@ -47,12 +97,13 @@ class SceneGraph {
                  Eigen::Isometry3f::Identity(),
              Key new_key = SceneGraph::GenerateNextKey());
 
-  /// Get a node reference at the key for changing it.
-  SceneGraph::Node& GetNode(Key key);
-  /// Get a const node reference at the key.
-  const SceneGraph::Node& GetNode(Key key) const;
+  /// Get a node at the key for changing it.
+  Node GetNode(Key key);
+  /// Get a node at the key that can only be read.
+  const Node GetNode(Key key) const;
 
-  /// Draw a key with all its children.
+  /// Draw a key with all its children. World transforms of the nodes are only
+  /// recomputed for nodes that moved since the last time they were needed.
   void Draw(Key key);
 
   /// Erase the node and all its children.
@@ -60,83 +111,71 @@ class SceneGraph {
   /// Erase all children of the node, but leave the node intact.
   int EraseChildren(Key key);
 
-  inline size_t size() const { return storage_.size(); }
-  inline bool HasNode(Key key) const { return storage_.count(key) > 0; }
+  inline size_t size() const { return handles_.size(); }
+  inline bool HasNode(Key key) const { return handles_.count(key) > 0; }
 
   /// Generate the next key to draw.
   static Key GenerateNextKey();
 
  private:
-  /// A single node of the graph. Holds a pointer to storage of all nodes.
-  class Node {
-   public:
-    using UniquePtr = std::unique_ptr<Node>;
-    using SharedPtr = std::shared_ptr<Node>;
-
-    Node(Key node_key,
-         Key parent_key,
-         Drawable::SharedPtr drawable,
-         const Eigen::Isometry3f& tf_parent_from_local_,
-         SceneGraph::Storage<UniquePtr>* storage);
-
-    /// Add a child key to the node.
-    inline void AddChildKey(Key key) { children_keys_.emplace(key); }
-    /// Erase a child key from the node.
-    inline int EraseChildKey(Key key) { return children_keys_.erase(key); }
-    /// Erase all children from the node.
-    inline void ClearChildKeys() noexcept { children_keys_.clear(); }
-
-    /// Draw this node at the correct position in the world.
-    void Draw(const Eigen::Isometry3f& tf_world_from_parent =
-                  Eigen::Isometry3f::Identity()) const;
-    Eigen::Isometry3f ComputeTfWorldFromLocal() const;
-
-    Key key() const { return key_; }
-    Key parent_key() const { return parent_key_; }
+  static constexpr Index kNoIndex{std::numeric_limits<Index>::max()};
 
-    Eigen::Isometry3f& tf_parent_from_local() { return tf_parent_from_local_; }
-    const Eigen::Isometry3f& tf_parent_from_local() const {
-      return tf_parent_from_local_;
-    }
-
-    const std::set<Key>& children_keys() const { return children_keys_; }
-
-    const Drawable::SharedPtr& drawable() const { return drawable_; }
-
-   private:
-    /// Key of this node.
-    Key key_{};
-    /// A key of a direct parent of this node.
-    Key parent_key_{};
-    /// Keys of all children of this node.
-    std::set<Key> children_keys_{};
-
-    /// Relative transformation from this coordinate frame to parent's one.
-    Eigen::Isometry3f tf_parent_from_local_{};
-
-    /// Every node is storing a drawable.
-    Drawable::SharedPtr drawable_{};
-
-    /// The nodes are stored elsewhere. We need the pointer to this place.
-    SceneGraph::Storage<Node::UniquePtr>* storage_{};
+  enum Flags : std::uint8_t {
+    kAlive = 1u << 0u,
+    kTfWorldFromLocalStale = 1u << 1u,
   };
 
-  /// This is a view of the storage that helps correctly erasing nodes.
-  class NodeEraser {
-   public:
-    explicit NodeEraser(SceneGraph::Storage<Node::UniquePtr>* storage);
-    int Erase(Key node);
-    int EraseChildren(Key node);
-
-   private:
-    void FindRecursiveChildren(Key key, std::set<Key>* children);
-    SceneGraph::Storage<Node::UniquePtr>* storage_{};
-  };
+  /// Find the handle of a node that must be in the graph.
+  Handle FindHandle(Key key) const;
+  /// Get a free slot for a new node, reusing the slots of erased nodes.
+  Index AllocateNode();
+  /// Add the node as the last child of the parent.
+  void LinkToParent(Index index, Index parent);
+  /// Remove the node from the children of its parent.
+  void UnlinkFromParent(Index index);
+  /// Erase the node and all its children. Returns the number of erased nodes.
+  int EraseSubtree(Index index);
+
+  /// Mark the world transformation of this node and its children as stale.
+  /// If a node is stale, so are all of its children, which lets this stop
+  /// early.
+  void InvalidateTfWorldFromLocal(Index index);
+  const Eigen::Isometry3f& ComputeTfWorldFromLocal(Index index);
+
+  /// Order the nodes so that every branch is a contiguous range in which
+  /// parents come before their children.
+  void UpdateDepthFirstOrder();
 
   static const Key kRootKey;
   static Key global_node_counter_;
 
-  Storage<Node::UniquePtr> storage_;
+  /// Handles of all nodes in the graph by their key.
+  std::unordered_map<Key, Handle> handles_;
+
+  /// The node arrays, one entry per slot.
+  std::vector<Key> keys_;
+  std::vector<std::uint32_t> generations_;
+  std::vector<std::uint8_t> flags_;
+  std::vector<Index> parents_;
+  std::vector<Index> first_children_;
+  std::vector<Index> last_children_;
+  std::vector<Index> next_siblings_;
+  std::vector<Index> previous_siblings_;
+  eigen::vector<Eigen::Isometry3f> tfs_parent_from_local_;
+  eigen::vector<Eigen::Isometry3f> tfs_world_from_local_;
+  std::vector<Drawable::SharedPtr> drawables_;
+  /// Position of every node in the depth-first order and the end of the range
+  /// its branch covers there.
+  std::vector<Index> depth_first_positions_;
+  std::vector<Index> depth_first_ends_;
+
+  /// Slots of erased nodes that can be reused.
+  std::vector<Index> free_indices_;
+
+  /// Indices of all nodes in depth-first order. Only updated before drawing
+  /// after nodes were attached or erased.
+  std::vector<Index> depth_first_order_;
+  bool depth_first_order_stale_{false};
 
   std::recursive_mutex graph_mutex;
 };
@@ -106,6 +106,49 @@ TEST_F(SceneGraphTest, ChainTransform) {
             2);
 }
 
+TEST_F(SceneGraphTest, MoveParentTransform) {
+  SceneGraph graph;
+  graph.RegisterBranchKey(world_key);
+  Eigen::Isometry3f test_transform = Eigen::Isometry3f::Identity();
+  test_transform.translation() = Eigen::Vector3f{1, 1, 1};
+  auto key_1 = graph.Attach(world_key, default_drawable_, test_transform);
+  auto key_2 = graph.Attach(key_1, default_drawable_, test_transform);
+  auto key_3 = graph.Attach(world_key, default_drawable_, test_transform);
+  EXPECT_EQ(graph.GetNode(key_2).ComputeTfWorldFromLocal().translation().x(),
+            2);
+  EXPECT_EQ(graph.GetNode(key_3).ComputeTfWorldFromLocal().translation().x(),
+            1);
+  test_transform.translation() = Eigen::Vector3f{3, 0, 0};
+  graph.GetNode(key_1).set_tf_parent_from_local(test_transform);
+  EXPECT_EQ(graph.GetNode(key_1).ComputeTfWorldFromLocal().translation().x(),
+            3);
+  EXPECT_EQ(graph.GetNode(key_2).ComputeTfWorldFromLocal().translation().x(),
+            4);
+  EXPECT_EQ(graph.GetNode(key_3).ComputeTfWorldFromLocal().translation().x(),
+            1);
+  // Children attached later use the latest transformation of their parents.
+  graph.GetNode(world_key).set_tf_parent_from_local(test_transform);
+  auto key_4 = graph.Attach(key_2, default_drawable_, test_transform);
+  EXPECT_EQ(graph.GetNode(key_4).ComputeTfWorldFromLocal().translation().x(),
+            10);
+  EXPECT_EQ(graph.GetNode(key_3).ComputeTfWorldFromLocal().translation().x(),
+            4);
+}
+
+TEST_F(SceneGraphTest, KeepTransformWhileAttaching) {
+  SceneGraph graph;
+  graph.RegisterBranchKey(world_key);
+  Eigen::Isometry3f test_transform = Eigen::Isometry3f::Identity();
+  test_transform.translation() = Eigen::Vector3f{1, 2, 3};
+  auto key = graph.Attach(world_key, default_drawable_, test_transform);
+  const auto& tf_world_from_local =
+      graph.GetNode(key).ComputeTfWorldFromLocal();
+  for (int i = 0; i < 100; ++i) {
+    graph.Attach(world_key, default_drawable_, test_transform);
+  }
+  EXPECT_EQ(tf_world_from_local.translation(), test_transform.translation());
+}
+
 TEST_F(SceneGraphTest, SimpleErase) {
   SceneGraph graph;
   graph.RegisterBranchKey(world_key);
@@ -192,3 +235,23 @@ TEST_F(SceneGraphTest, BroadErase) {
   EXPECT_FALSE(graph.HasNode(key_3));
   EXPECT_FALSE(graph.HasNode(key_4));
 }
+
+TEST_F(SceneGraphTest, ReuseErasedNodes) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  SceneGraph graph;
+  graph.RegisterBranchKey(world_key);
+  auto key_1 = graph.Attach(world_key, default_drawable_);
+  auto key_2 = graph.Attach(world_key, default_drawable_);
+  auto key_3 = graph.Attach(key_2, default_drawable_);
+  const auto erased_node = graph.GetNode(key_2);
+  EXPECT_EQ(2, graph.Erase(key_2));
+  // The new nodes take the places of the erased ones.
+  auto key_4 = graph.Attach(key_1, default_drawable_);
+  auto key_5 = graph.Attach(world_key, default_drawable_);
+  EXPECT_EQ(graph.size(), 4u);
+  EXPECT_FALSE(graph.HasNode(key_3));
+  EXPECT_DEATH(erased_node.key(), "The node was erased from the graph");
+  EXPECT_EQ(graph.GetNode(key_4).parent_key(), key_1);
+  const std::vector<SceneGraph::Key> expected_children{key_1, key_5};
+  EXPECT_EQ(graph.GetNode(world_key).children_keys(), expected_children);
+}
@@ -0,0 +1,12 @@
+#version 330
+layout (location = 0) out vec4 result_color;
+
+in vec2 tex_coord;
+in vec3 glyph_color;
+
+uniform sampler2D source;
+uniform vec3 color;
+
+void main() {
+    result_color = vec4(color * glyph_color, texture(source, tex_coord).a);
+}
@@ -1,14 +1,24 @@
 #version 330
-layout (location = 0) in vec2 char_pos;
-layout (location = 1) in vec2 texture_pos;
+layout (location = 0) in vec3 anchor;
+layout (location = 1) in vec3 label_color;
+layout (location = 2) in vec4 glyph_rect;
+layout (location = 3) in vec4 texture_rect;
 
 uniform mat4 proj_view;
 uniform mat4 model;
-uniform vec3 anchor;
 
 out vec2 tex_coord;
+out vec3 glyph_color;
 
 void main() {
-  gl_Position = proj_view * model * vec4(anchor, 1) + vec4(char_pos, 0, 0);
-  tex_coord = texture_pos;
+  // Every glyph is an instance of a quad, its corners come from the index of
+  // the vertex.
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+  vec2 char_pos = mix(glyph_rect.xy, glyph_rect.zw, corner);
+  // Offsets are in normalized device coordinates, so the text always faces
+  // the camera and keeps its size on the screen.
+  vec4 position = proj_view * model * vec4(anchor, 1);
+  gl_Position = position + vec4(char_pos * position.w, 0, 0);
+  tex_coord = mix(texture_rect.xy, texture_rect.zw, corner);
+  glyph_color = label_color;
 }
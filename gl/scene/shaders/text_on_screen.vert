@@ -0,0 +1,18 @@
+#version 330
+layout (location = 0) in vec3 anchor;
+layout (location = 1) in vec3 label_color;
+layout (location = 2) in vec4 glyph_rect;
+layout (location = 3) in vec4 texture_rect;
+
+uniform mat4 model;
+
+out vec2 tex_coord;
+out vec3 glyph_color;
+
+void main() {
+  vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+  vec2 char_pos = mix(glyph_rect.xy, glyph_rect.zw, corner);
+  gl_Position = model * vec4(anchor, 1) + vec4(char_pos, 0, 0);
+  tex_coord = mix(texture_rect.xy, texture_rect.zw, corner);
+  glyph_color = label_color;
+}
@@ -0,0 +1,18 @@
+#version 330
+layout (location = 0) out vec4 result_color;
+
+in vec2 tex_coord;
+in vec3 glyph_color;
+
+uniform sampler2D source;
+uniform vec3 color;
+
+void main() {
+    // The font texture stores the distance to the glyph edge, where 0.5 is the
+    // edge. Blending over the width of one screen pixel keeps the edges sharp
+    // and smooth at any text size.
+    float distance = texture(source, tex_coord).r;
+    float width = fwidth(distance);
+    float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+    result_color = vec4(color * glyph_color, alpha);
+}
@@ -0,0 +1,63 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#include "gl/scene/text_layout.h"
+
+#include <functional>
+#include <utility>
+
+namespace gl {
+
+TextLayout TextLayout::Create(const Font& font,
+                              const std::string& text,
+                              float line_height) {
+  TextLayout layout{font.LayoutString(text)};
+  const float scale{line_height / font.line_height()};
+  for (auto& glyph : layout.glyphs) {
+    glyph.min_x *= scale;
+    glyph.min_y *= scale;
+    glyph.max_x *= scale;
+    glyph.max_y *= scale;
+  }
+  return layout;
+}
+
+std::size_t TextLayoutCache::KeyHash::operator()(const Key& key) const {
+  std::size_t hash{std::hash<std::string>{}(key.text)};
+  for (const auto other : {std::hash<std::string>{}(key.font_name),
+                           std::hash<float>{}(key.line_height)}) {
+    hash ^= other + 0x9e3779b9ul + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::Get(
+    const Font& font, const std::string& text, float line_height) {
+  Key key{font.name(), text, line_height};
+  const auto entry_iter{entries_.find(key)};
+  if (entry_iter != entries_.end()) {
+    ++hits_;
+    auto& entry{entry_iter->second};
+    lru_order_.splice(lru_order_.begin(), lru_order_, entry.lru_position);
+    return entry.layout;
+  }
+  ++misses_;
+  auto layout{std::make_shared<const TextLayout>(
+      TextLayout::Create(font, text, line_height))};
+  if (capacity_ == 0ul) { return layout; }
+  if (entries_.size() >= capacity_) {
+    entries_.erase(lru_order_.back());
+    lru_order_.pop_back();
+  }
+  lru_order_.push_front(key);
+  entries_.emplace(std::move(key), Entry{layout, lru_order_.begin()});
+  return layout;
+}
+
+void TextLayoutCache::Clear() {
+  entries_.clear();
+  lru_order_.clear();
+}
+
+}  // namespace gl
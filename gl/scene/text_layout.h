@@ -0,0 +1,98 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#ifndef OPENGL_TUTORIALS_GL_SCENE_TEXT_LAYOUT_H_
+#define OPENGL_TUTORIALS_GL_SCENE_TEXT_LAYOUT_H_
+
+#include "gl/scene/font.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gl {
+
+/// Quads of all the glyphs of a text, ready to be put into an instance
+/// buffer.
+///
+/// The text starts at the origin and goes to the right, lines go down. The
+/// corners of every quad are offsets from the origin of the text scaled to
+/// the line height, the texture coordinates are the ones of the font.
+struct TextLayout {
+  std::vector<Font::GlyphQuad> glyphs{};
+
+  /// Lay out a text with a given line height. Symbols missing in the font are
+  /// skipped.
+  static TextLayout Create(const Font& font,
+                           const std::string& text,
+                           float line_height);
+
+  std::size_t number_of_glyphs() const noexcept { return glyphs.size(); }
+};
+
+/// Keeps the layouts of recently used texts, so that texts that are shown
+/// again, e.g., labels that switch between a few states, are not laid out
+/// again. Layouts are keyed by the font name, the text and its line height.
+/// The least recently used layouts are dropped when the cache is full.
+class TextLayoutCache {
+ public:
+  static constexpr std::size_t kDefaultCapacity{1024ul};
+
+  explicit TextLayoutCache(std::size_t capacity = kDefaultCapacity)
+      : capacity_{capacity} {}
+  TextLayoutCache(const TextLayoutCache&) = delete;
+  TextLayoutCache& operator=(const TextLayoutCache&) = delete;
+  TextLayoutCache(TextLayoutCache&&) = default;
+  TextLayoutCache& operator=(TextLayoutCache&&) = default;
+  ~TextLayoutCache() noexcept = default;
+
+  /// Get the layout of a text, laying it out only if it is not in the cache.
+  std::shared_ptr<const TextLayout> Get(const Font& font,
+                                        const std::string& text,
+                                        float line_height);
+
+  void Clear();
+
+  /// Number of layouts in the cache.
+  std::size_t size() const noexcept { return entries_.size(); }
+  std::size_t capacity() const noexcept { return capacity_; }
+
+  std::size_t hits() const noexcept { return hits_; }
+  std::size_t misses() const noexcept { return misses_; }
+
+ private:
+  struct Key {
+    std::string font_name;
+    std::string text;
+    float line_height;
+
+    bool operator==(const Key& other) const {
+      return line_height == other.line_height && text == other.text &&
+             font_name == other.font_name;
+    }
+  };
+
+  struct KeyHash {
+    std::size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    std::shared_ptr<const TextLayout> layout{};
+    std::list<Key>::iterator lru_position{};
+  };
+
+  std::unordered_map<Key, Entry, KeyHash> entries_{};
+  /// Keys of the layouts, the most recently used ones first.
+  std::list<Key> lru_order_{};
+
+  std::size_t capacity_{};
+  std::size_t hits_{};
+  std::size_t misses_{};
+};
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_GL_SCENE_TEXT_LAYOUT_H_
@@ -0,0 +1,227 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#include "gl/scene/drawables/all.h"
+#include "gl/scene/text_layout.h"
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using gl::Font;
+using gl::ProgramPool;
+using gl::Shader;
+using gl::TextBatch;
+using gl::TextLayout;
+using gl::TextLayoutCache;
+
+TEST(TextLayoutTest, QuadPerGlyph) {
+  const Font font{"gl/scene/fonts/ubuntu.fnt"};
+  const auto layout{TextLayout::Create(font, "ab c", 10.0f)};
+  // Spaces only move the pen.
+  ASSERT_EQ(3ul, layout.number_of_glyphs());
+  // Glyphs go from left to right and are not higher than the line.
+  EXPECT_LT(layout.glyphs[0].min_x, layout.glyphs[1].min_x);
+  EXPECT_LT(layout.glyphs[1].min_x, layout.glyphs[2].min_x);
+  for (const auto& glyph : layout.glyphs) {
+    EXPECT_LT(glyph.min_x, glyph.max_x);
+    EXPECT_GE(glyph.min_y, 0.0f);
+    EXPECT_LE(glyph.max_y, 10.0f);
+  }
+  // Texture coordinates of a glyph span its rectangle in the font texture.
+  const auto& coords{font.GetCharCoords('a')};
+  EXPECT_FLOAT_EQ(coords.x, layout.glyphs[0].min_u);
+  EXPECT_FLOAT_EQ(coords.x + coords.width, layout.glyphs[0].max_u);
+}
+
+TEST(TextLayoutTest, NewLineGoesDown) {
+  const Font font{"gl/scene/fonts/ubuntu.fnt"};
+  const auto layout{TextLayout::Create(font, "a\na", 10.0f)};
+  ASSERT_EQ(2ul, layout.number_of_glyphs());
+  EXPECT_FLOAT_EQ(layout.glyphs[0].min_x, layout.glyphs[1].min_x);
+  EXPECT_FLOAT_EQ(layout.glyphs[0].min_y - 10.0f, layout.glyphs[1].min_y);
+  EXPECT_EQ(0ul, TextLayout::Create(font, "\n \n", 10.0f).number_of_glyphs());
+}
+
+TEST(TextLayoutCacheTest, ReuseLayouts) {
+  const Font font{"gl/scene/fonts/ubuntu.fnt"};
+  TextLayoutCache cache{2ul};
+  const auto layout{cache.Get(font, "fps: 60", 10.0f)};
+  ASSERT_NE(nullptr, layout);
+  EXPECT_EQ(6ul, layout->number_of_glyphs());
+  EXPECT_EQ(layout, cache.Get(font, "fps: 60", 10.0f));
+  // A different scale is a different layout.
+  EXPECT_NE(layout, cache.Get(font, "fps: 60", 20.0f));
+  EXPECT_EQ(1ul, cache.hits());
+  EXPECT_EQ(2ul, cache.misses());
+  EXPECT_EQ(2ul, cache.size());
+  // Use the first layout again, so that the second one is evicted.
+  cache.Get(font, "fps: 60", 10.0f);
+  cache.Get(font, "fps: 59", 10.0f);
+  EXPECT_EQ(2ul, cache.size());
+  EXPECT_EQ(layout, cache.Get(font, "fps: 60", 10.0f));
+  cache.Clear();
+  EXPECT_EQ(0ul, cache.size());
+  // Layouts that are still used stay valid after they leave the cache.
+  EXPECT_EQ(6ul, layout->number_of_glyphs());
+}
+
+TEST(TextLayoutCacheTest, ZeroCapacity) {
+  const Font font{"gl/scene/fonts/ubuntu.fnt"};
+  TextLayoutCache cache{0ul};
+  const auto layout{cache.Get(font, "abc", 10.0f)};
+  EXPECT_EQ(3ul, layout->number_of_glyphs());
+  EXPECT_NE(layout, cache.Get(font, "abc", 10.0f));
+  EXPECT_EQ(0ul, cache.size());
+}
+
+TEST(TextBatchTest, AllLabelsInOneBuffer) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/text.vert", "gl/scene/shaders/text.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  const auto font{std::make_shared<Font>("gl/scene/fonts/ubuntu.fnt")};
+  TextBatch batch{&pool, program_index.value(), font};
+  batch.AddLabel("abc", {1.0f, 2.0f, 3.0f});
+  batch.AddLabel("d e", {-1.0f, 0.0f, 0.0f});
+  EXPECT_FALSE(batch.ready_to_draw());
+  batch.FillBuffers();
+  EXPECT_TRUE(batch.ready_to_draw());
+  EXPECT_EQ(2ul, batch.number_of_labels());
+  EXPECT_EQ(5ul, batch.number_of_glyphs());
+  EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+  batch.AddLabel("f", Eigen::Vector3f::Zero());
+  EXPECT_FALSE(batch.ready_to_draw());
+}
+
+TEST(TextBatchTest, LabelColors) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/text.vert", "gl/scene/shaders/text.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  TextBatch batch{&pool,
+                  program_index.value(),
+                  std::make_shared<Font>("gl/scene/fonts/ubuntu.fnt")};
+  batch.AddLabel("id: 1", Eigen::Vector3f::Zero(), 0ul, {1.0f, 0.0f, 0.0f});
+  const auto label{batch.AddLabel("id: 2", Eigen::Vector3f::UnitX())};
+  batch.FillBuffers();
+  // Colors are changed in place.
+  batch.SetLabelColor(label, {0.0f, 1.0f, 0.0f});
+  EXPECT_TRUE(batch.ready_to_draw());
+  EXPECT_EQ(8ul, batch.number_of_glyphs());
+  EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+}
+
+TEST(TextBatchTest, HideLabels) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/text.vert", "gl/scene/shaders/text.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  TextBatch batch{&pool,
+                  program_index.value(),
+                  std::make_shared<Font>("gl/scene/fonts/ubuntu.fnt"),
+                  0.1f};
+  batch.AddLabel("first", Eigen::Vector3f::Zero());
+  batch.AddLabel("second", Eigen::Vector3f::UnitX());
+  EXPECT_EQ(Eigen::Vector3f::UnitX(), batch.label_anchor(1));
+  // The extent starts at the anchor and is about as high as the text.
+  const auto extent{batch.ComputeLabelExtent(0)};
+  EXPECT_GE(extent.min().x(), 0.0f);
+  EXPECT_GT(extent.max().x(), extent.min().x());
+  EXPECT_GT(extent.max().y(), 0.05f);
+  EXPECT_LE(extent.max().y(), 0.1f);
+  batch.SetLabelsVisible({true, false});
+  batch.FillBuffers();
+  // Visibility changes do not need to fill the buffers again.
+  batch.SetLabelsVisible({false, true});
+  EXPECT_TRUE(batch.ready_to_draw());
+  EXPECT_EQ(11ul, batch.number_of_glyphs());
+  EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+}
+
+TEST(TextBatchTest, DrawOnScreen) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(
+      Shader::CreateFromFiles({"gl/scene/shaders/text_on_screen.vert",
+                               "gl/scene/shaders/text.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  gl::Text text{&pool,
+                program_index.value(),
+                std::make_shared<Font>("gl/scene/fonts/ubuntu.fnt"),
+                "Hello\nworld"};
+  text.FillBuffers();
+  EXPECT_EQ(1ul, text.number_of_labels());
+  EXPECT_EQ(10ul, text.number_of_glyphs());
+  EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+}
+
+TEST(TextBatchTest, DistanceFieldFont) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(Shader::CreateFromFiles(
+      {"gl/scene/shaders/text.vert", "gl/scene/shaders/text_sdf.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  TextBatch batch{&pool,
+                  program_index.value(),
+                  std::make_shared<Font>("gl/scene/fonts/ubuntu_sdf.fnt")};
+  batch.AddLabel("small", Eigen::Vector3f::Zero());
+  batch.AddLabel("large", Eigen::Vector3f::UnitX());
+  batch.FillBuffers();
+  EXPECT_EQ(10ul, batch.number_of_glyphs());
+  EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+}
+
+TEST(TextBatchTest, UpdateLabelInPlace) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(
+      Shader::CreateFromFiles({"gl/scene/shaders/text_on_screen.vert",
+                               "gl/scene/shaders/text.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  TextLayoutCache cache{};
+  TextBatch batch{&pool,
+                  program_index.value(),
+                  std::make_shared<Font>("gl/scene/fonts/ubuntu.fnt")};
+  batch.SetLayoutCache(&cache);
+  batch.AddLabel("title", Eigen::Vector3f::Zero());
+  const auto fps_label{batch.AddLabel("fps: 60", Eigen::Vector3f::UnitY(), 10)};
+  EXPECT_EQ(1ul, fps_label);
+  batch.FillBuffers();
+  EXPECT_EQ(11ul, batch.number_of_glyphs());
+  // Texts that fit into the reserved glyphs do not refill the buffers.
+  batch.SetLabelText(fps_label, "fps: 144");
+  EXPECT_TRUE(batch.ready_to_draw());
+  EXPECT_EQ(12ul, batch.number_of_glyphs());
+  batch.SetLabelText(fps_label, "fps: 9");
+  EXPECT_TRUE(batch.ready_to_draw());
+  EXPECT_EQ(10ul, batch.number_of_glyphs());
+  EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+  // Texts that do not fit need new buffers.
+  batch.SetLabelText(0ul, "a much longer title");
+  EXPECT_FALSE(batch.ready_to_draw());
+  batch.FillBuffers();
+  EXPECT_EQ(21ul, batch.number_of_glyphs());
+  EXPECT_EQ(5ul, cache.size());
+}
+
+TEST(TextBatchTest, SetText) {
+  ProgramPool pool{};
+  const auto program_index{pool.AddProgramFromShaders(
+      Shader::CreateFromFiles({"gl/scene/shaders/text_on_screen.vert",
+                               "gl/scene/shaders/text.frag"}))};
+  ASSERT_TRUE(program_index.has_value());
+  gl::Text text{&pool,
+                program_index.value(),
+                std::make_shared<Font>("gl/scene/fonts/ubuntu.fnt"),
+                "0",
+                Eigen::Vector3f::Zero(),
+                0.05f,
+                {1.0f, 1.0f, 1.0f},
+                4ul};
+  // The text is laid out when the buffers are filled.
+  text.SetText("12");
+  text.FillBuffers();
+  EXPECT_EQ(2ul, text.number_of_glyphs());
+  text.SetText("1234");
+  EXPECT_TRUE(text.ready_to_draw());
+  EXPECT_EQ(4ul, text.number_of_glyphs());
+  EXPECT_EQ(static_cast<GLenum>(GL_NO_ERROR), glGetError());
+}
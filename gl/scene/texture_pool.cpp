@@ -0,0 +1,166 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#include "gl/scene/texture_pool.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+/// Textures created from images keep the pixel format of the image and have a
+/// full mip chain.
+std::size_t EstimateTextureBytes(const utils::Image& image) {
+  const std::size_t kBytesPerPixel{image.number_of_channels() *
+                                   image.bytes_per_channel()};
+  std::size_t bytes{};
+  int width{image.width()};
+  int height{image.height()};
+  while (true) {
+    bytes += kBytesPerPixel * width * height;
+    if (width == 1 && height == 1) { break; }
+    width = std::max(1, width / 2);
+    height = std::max(1, height / 2);
+  }
+  return bytes;
+}
+
+/// The finalizer of splitmix64.
+std::uint64_t Mix(std::uint64_t value) {
+  value ^= value >> 30u;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value >> 27u;
+  value *= 0x94d049bb133111ebull;
+  return value ^ (value >> 31u);
+}
+
+std::shared_ptr<gl::Texture> BuildTexture(const utils::Image& image) {
+  return gl::Texture::Builder{gl::Texture::Type::kTexture2D,
+                              gl::Texture::Identifier::kTexture0}
+      .WithSaneDefaults()
+      .WithImage(image)
+      .Build();
+}
+
+}  // namespace
+
+namespace gl {
+
+TexturePool::ContentKey TexturePool::ComputeContentKey(
+    const utils::Image& image) {
+  // 64-bit FNV-1a over the bytes and a splitmix64 based hash over 8-byte
+  // words. Both work differently, so their collisions are independent.
+  constexpr std::uint64_t kOffsetBasis{14695981039346656037ull};
+  constexpr std::uint64_t kPrime{1099511628211ull};
+  ContentKey key{kOffsetBasis, 0ull};
+  const auto add_byte = [&key](std::uint8_t byte) {
+    key.fnv_hash ^= byte;
+    key.fnv_hash *= kPrime;
+  };
+  const auto add_word = [&key](std::uint64_t word) {
+    key.mix_hash = Mix(key.mix_hash + 0x9e3779b97f4a7c15ull + word);
+  };
+  for (const auto dimension : {image.width(),
+                               image.height(),
+                               image.number_of_channels(),
+                               static_cast<int>(image.data_type())}) {
+    for (int shift = 0; shift < 32; shift += 8) {
+      add_byte(static_cast<std::uint8_t>(dimension >> shift));
+    }
+    add_word(static_cast<std::uint32_t>(dimension));
+  }
+  if (image.data() == nullptr) { return key; }
+  const std::size_t number_of_bytes{image.size_in_bytes()};
+  for (std::size_t i = 0; i < number_of_bytes; ++i) {
+    add_byte(image.data()[i]);
+  }
+  for (std::size_t i = 0; i < number_of_bytes; i += sizeof(std::uint64_t)) {
+    std::uint64_t word{};
+    std::memcpy(&word,
+                image.data() + i,
+                std::min(sizeof(word), number_of_bytes - i));
+    add_word(word);
+  }
+  // The last word is padded with zeros, so also hash the number of bytes.
+  add_word(number_of_bytes);
+  return key;
+}
+
+std::shared_ptr<Texture> TexturePool::LoadTexture(
+    const std::filesystem::path& path, bool flip_vertically) {
+  const PathKey path_key{path.string(), flip_vertically};
+  const auto key_iter{keys_by_path_.find(path_key)};
+  if (key_iter != keys_by_path_.end()) {
+    return Touch(entries_.at(key_iter->second));
+  }
+  const auto image{utils::Image::CreateFrom(path, flip_vertically)};
+  if (!image || image->data() == nullptr) {
+    LOG(WARNING) << "Cannot load a texture from " << path;
+    return nullptr;
+  }
+  const auto key{ComputeContentKey(image.value())};
+  auto texture{AddTexture(image.value(), key)};
+  if (texture) { keys_by_path_[path_key] = key; }
+  return texture;
+}
+
+std::shared_ptr<Texture> TexturePool::AddTexture(const utils::Image& image) {
+  if (image.data() == nullptr) {
+    LOG(WARNING) << "Cannot create a texture from an empty image.";
+    return nullptr;
+  }
+  return AddTexture(image, ComputeContentKey(image));
+}
+
+std::shared_ptr<Texture> TexturePool::AddTexture(const utils::Image& image,
+                                                 const ContentKey& key) {
+  const auto entry_iter{entries_.find(key)};
+  if (entry_iter != entries_.end()) { return Touch(entry_iter->second); }
+
+  Entry entry{};
+  entry.texture = BuildTexture(image);
+  entry.bytes = EstimateTextureBytes(image);
+  lru_order_.push_front(key);
+  entry.lru_position = lru_order_.begin();
+  used_bytes_ += entry.bytes;
+  auto texture{entries_.emplace(key, std::move(entry)).first->second.texture};
+  // The new texture is held by the caller, so it will not be evicted here.
+  EvictUnusedTextures();
+  return texture;
+}
+
+void TexturePool::EvictUnusedTextures() {
+  auto lru_iter{lru_order_.end()};
+  while (used_bytes_ > budget_in_bytes_ && lru_iter != lru_order_.begin()) {
+    --lru_iter;
+    const auto key{*lru_iter};
+    auto& entry{entries_.at(key)};
+    // Somebody still uses this texture, so it cannot be freed.
+    if (entry.texture.use_count() > 1) { continue; }
+    used_bytes_ -= entry.bytes;
+    entries_.erase(key);
+    lru_iter = lru_order_.erase(lru_iter);
+    for (auto iter = keys_by_path_.begin(); iter != keys_by_path_.end();) {
+      if (iter->second == key) {
+        iter = keys_by_path_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+  }
+}
+
+void TexturePool::set_budget_in_bytes(std::size_t budget_in_bytes) {
+  budget_in_bytes_ = budget_in_bytes;
+  EvictUnusedTextures();
+}
+
+const std::shared_ptr<Texture>& TexturePool::Touch(Entry& entry) {
+  lru_order_.splice(lru_order_.begin(), lru_order_, entry.lru_position);
+  return entry.texture;
+}
+
+}  // namespace gl
@@ -0,0 +1,111 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#ifndef OPENGL_TUTORIALS_GL_SCENE_TEXTURE_POOL_H_
+#define OPENGL_TUTORIALS_GL_SCENE_TEXTURE_POOL_H_
+
+#include "gl/core/texture.h"
+#include "utils/image.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace gl {
+
+/// Container for textures that are shared between drawables.
+///
+/// Textures are deduplicated by the path they were loaded from and by their
+/// contents, so the same image is only decoded and uploaded once. Contents
+/// are compared by a 128-bit hash, so the pool does not need to keep the
+/// pixels around. The pool also tracks how much GPU memory its textures take
+/// and frees the least recently used textures that nobody else holds anymore
+/// when it takes more than the budget.
+class TexturePool {
+ public:
+  static constexpr std::size_t kDefaultBudgetInBytes{256ul * 1024ul * 1024ul};
+
+  explicit TexturePool(std::size_t budget_in_bytes = kDefaultBudgetInBytes)
+      : budget_in_bytes_{budget_in_bytes} {}
+  TexturePool(const TexturePool&) = delete;
+  TexturePool& operator=(const TexturePool&) = delete;
+  TexturePool(TexturePool&&) = default;
+  TexturePool& operator=(TexturePool&&) = default;
+  ~TexturePool() noexcept = default;
+
+  /// Get a texture with the image from this path. The image is only loaded
+  /// if no texture for this path or with the same contents is in the pool.
+  /// Returns nullptr if the image cannot be loaded.
+  std::shared_ptr<Texture> LoadTexture(const std::filesystem::path& path,
+                                       bool flip_vertically = false);
+
+  /// Get a texture with this image. A new texture is only created if there
+  /// is no texture with the same contents in the pool.
+  std::shared_ptr<Texture> AddTexture(const utils::Image& image);
+
+  /// Free the least recently used textures that are only held by the pool
+  /// until the pool fits into its budget.
+  void EvictUnusedTextures();
+
+  /// Change the budget. This evicts unused textures if needed.
+  void set_budget_in_bytes(std::size_t budget_in_bytes);
+  std::size_t budget_in_bytes() const noexcept { return budget_in_bytes_; }
+
+  /// Estimated GPU memory taken by all textures in the pool.
+  std::size_t used_bytes() const noexcept { return used_bytes_; }
+
+  /// Number of textures in the pool.
+  std::size_t size() const noexcept { return entries_.size(); }
+
+  /// Two independent 64-bit hashes of the image size, type and pixels.
+  /// Different images practically never get the same pair.
+  struct ContentKey {
+    std::uint64_t fnv_hash{};
+    std::uint64_t mix_hash{};
+
+    bool operator==(const ContentKey& other) const {
+      return fnv_hash == other.fnv_hash && mix_hash == other.mix_hash;
+    }
+  };
+
+  static ContentKey ComputeContentKey(const utils::Image& image);
+
+ private:
+  using PathKey = std::pair<std::string, bool>;
+
+  struct KeyHash {
+    std::size_t operator()(const ContentKey& key) const {
+      return static_cast<std::size_t>(key.fnv_hash);
+    }
+  };
+
+  struct Entry {
+    std::shared_ptr<Texture> texture{};
+    std::size_t bytes{};
+    std::list<ContentKey>::iterator lru_position{};
+  };
+
+  std::shared_ptr<Texture> AddTexture(const utils::Image& image,
+                                      const ContentKey& key);
+
+  /// Mark the texture as used right now.
+  const std::shared_ptr<Texture>& Touch(Entry& entry);
+
+  std::unordered_map<ContentKey, Entry, KeyHash> entries_{};
+  std::map<PathKey, ContentKey> keys_by_path_{};
+  /// Content keys of textures, the most recently used ones first.
+  std::list<ContentKey> lru_order_{};
+
+  std::size_t budget_in_bytes_{};
+  std::size_t used_bytes_{};
+};
+
+}  // namespace gl
+
+#endif  // OPENGL_TUTORIALS_GL_SCENE_TEXTURE_POOL_H_
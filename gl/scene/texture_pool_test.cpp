@@ -0,0 +1,74 @@
+// Copyright Igor Bogoslavskyi, year 2020.
+// In case of any problems with the code please contact me.
+// Email: <name>.<family_name>@gmail.com.
+
+#include "gl/scene/texture_pool.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using gl::TexturePool;
+
+namespace {
+utils::Image CreateFilledImage(int size, std::uint8_t value) {
+  const std::vector<std::uint8_t> data(size * size * 3, value);
+  return utils::Image::CreateFromData(size, size, 3, data.data());
+}
+}  // namespace
+
+TEST(TexturePoolTest, DeduplicateByPath) {
+  TexturePool pool{};
+  const auto texture{pool.LoadTexture("utils/test_images/container.jpg")};
+  ASSERT_NE(nullptr, texture);
+  EXPECT_EQ(texture, pool.LoadTexture("utils/test_images/container.jpg"));
+  EXPECT_EQ(1ul, pool.size());
+  // 512x512 RGB texture with a full mip chain.
+  EXPECT_EQ(1048575ul, pool.used_bytes());
+  EXPECT_EQ(nullptr, pool.LoadTexture("non_existing_path"));
+}
+
+TEST(TexturePoolTest, DeduplicateByContent) {
+  TexturePool pool{};
+  const auto texture{pool.AddTexture(CreateFilledImage(4, 42))};
+  ASSERT_NE(nullptr, texture);
+  EXPECT_EQ(texture, pool.AddTexture(CreateFilledImage(4, 42)));
+  EXPECT_NE(texture, pool.AddTexture(CreateFilledImage(4, 43)));
+  EXPECT_EQ(2ul, pool.size());
+}
+
+TEST(TexturePoolTest, ContentKeyDependsOnEverything) {
+  const auto key{TexturePool::ComputeContentKey(CreateFilledImage(4, 42))};
+  EXPECT_EQ(key, TexturePool::ComputeContentKey(CreateFilledImage(4, 42)));
+  std::vector<std::uint8_t> data(4 * 4 * 3, 42);
+  data.back() = 43;
+  const auto other_key{TexturePool::ComputeContentKey(
+      utils::Image::CreateFromData(4, 4, 3, data.data()))};
+  EXPECT_NE(key.fnv_hash, other_key.fnv_hash);
+  EXPECT_NE(key.mix_hash, other_key.mix_hash);
+  // The same bytes with a different shape.
+  const auto reshaped_key{TexturePool::ComputeContentKey(
+      utils::Image::CreateFromData(8, 2, 3, data.data()))};
+  EXPECT_NE(other_key.fnv_hash, reshaped_key.fnv_hash);
+  EXPECT_NE(other_key.mix_hash, reshaped_key.mix_hash);
+}
+
+TEST(TexturePoolTest, EvictLeastRecentlyUsed) {
+  // Every 8x8 RGB texture takes 255 bytes with mips.
+  TexturePool pool{520ul};
+  auto first{pool.AddTexture(CreateFilledImage(8, 1))};
+  auto second{pool.AddTexture(CreateFilledImage(8, 2))};
+  auto third{pool.AddTexture(CreateFilledImage(8, 3))};
+  // All textures are in use, so none of them can be evicted.
+  EXPECT_EQ(3ul, pool.size());
+  EXPECT_EQ(765ul, pool.used_bytes());
+  first.reset();
+  second.reset();
+  // Use the first texture again, so that the second one is the oldest.
+  pool.AddTexture(CreateFilledImage(8, 1));
+  pool.EvictUnusedTextures();
+  EXPECT_EQ(2ul, pool.size());
+  EXPECT_EQ(510ul, pool.used_bytes());
+  pool.set_budget_in_bytes(0ul);
+  EXPECT_EQ(1ul, pool.size());
+  EXPECT_EQ(third, pool.AddTexture(CreateFilledImage(8, 3)));
+}
@@ -7,6 +7,8 @@
 #include "gl/scene/program_pool.h"
 #include "nholthaus/units.h"
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 
 namespace gl {
@@ -14,7 +16,8 @@ namespace gl {
 void SceneViewer::Initialize(const glfw::WindowSize& window_size,
                              const glfw::GlVersion& gl_version) {
   CHECK(viewer_.Initialize(window_size, gl_version));
-  FontPool::Instance().LoadFont("gl/scene/fonts/ubuntu.fnt");
+  // Fonts are only needed once something draws text, so do not wait for them.
+  FontPool::Instance().PreloadFont("gl/scene/fonts/ubuntu.fnt");
   opengl_initialized_ = true;
 
   world_key_ = graph_.RegisterBranchKey();
@@ -27,6 +30,7 @@ void SceneViewer::Paint() {
   glClearColor(0.1, 0.1, 0.1, 0.5);
   glEnable(GL_DEPTH_TEST);
   glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  texture_unit_allocator_.BeginFrame();
   graph_.Draw(world_key_);
   graph_.Draw(viewport_key_);
   graph_.Draw(camera_key_);
@@ -38,6 +42,50 @@ void SceneViewer::EraseScheduledKeys() {
   keys_to_remove_.clear();
 }
 
+void SceneViewer::DeclutterLabels(const std::shared_ptr<TextBatch>& labels,
+                                  const std::vector<float>& priorities) {
+  CHECK(labels) << "Need labels to declutter.";
+  CHECK_EQ(labels->number_of_labels(), priorities.size())
+      << "Need a priority for every label.";
+  std::vector<LabelDeclutterer::Label> declutterer_labels{};
+  declutterer_labels.reserve(priorities.size());
+  for (std::size_t i = 0; i < priorities.size(); ++i) {
+    declutterer_labels.push_back({labels->label_anchor(i),
+                                  labels->ComputeLabelExtent(i),
+                                  priorities[i]});
+  }
+  auto iter{std::find_if(
+      decluttered_labels_.begin(),
+      decluttered_labels_.end(),
+      [&labels](const auto& entry) { return entry.labels == labels; })};
+  if (iter == decluttered_labels_.end()) {
+    decluttered_labels_.push_back(
+        {labels, std::make_unique<LabelDeclutterer>(), {}});
+    iter = std::prev(decluttered_labels_.end());
+  }
+  iter->declutterer->SetLabels(std::move(declutterer_labels));
+}
+
+void SceneViewer::UpdateLabelVisibility() {
+  const Eigen::Matrix4f tf_viewport_world{camera_.TfViewportWorld()};
+  for (auto& entry : decluttered_labels_) {
+    if (entry.visibility.valid()) {
+      // Never wait for the worker, the labels of the previous frame can stay
+      // for one more frame.
+      if (entry.visibility.wait_for(std::chrono::seconds{0}) !=
+          std::future_status::ready) {
+        continue;
+      }
+      const auto visibility{entry.visibility.get()};
+      // Skip stale results if labels were added to the batch since.
+      if (visibility.size() == entry.labels->number_of_labels()) {
+        entry.labels->SetLabelsVisible(visibility);
+      }
+    }
+    entry.visibility = entry.declutterer->DeclutterAsync(tf_viewport_world);
+  }
+}
+
 void SceneViewer::Spin() {
   viewer_.user_input_handler().RegisterMouseCallback(
       std::bind(&SceneViewer::OnMouseEvent,
@@ -50,6 +98,8 @@ void SceneViewer::Spin() {
   while (!viewer_.ShouldClose()) {
     viewer_.ProcessInput();
     EraseScheduledKeys();
+    UpdateLabelVisibility();
+    texture_pool_.EvictUnusedTextures();
     Paint();
     viewer_.Spin();
   }
@@ -113,8 +163,8 @@ void SceneViewer::OnKeyboardEvent(const std::set<gl::core::KeyboardKey>& keys) {
 
 void SceneViewer::UpdateCameraNodePosition() {
   CHECK(graph_.HasNode(camera_key_));
-  graph_.GetNode(camera_key_).tf_parent_from_local() =
-      camera_.tf_world_from_target();
+  graph_.GetNode(camera_key_).set_tf_parent_from_local(
+      camera_.tf_world_from_target());
 }
 
 }  // namespace gl
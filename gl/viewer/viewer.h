@@ -5,10 +5,17 @@
 #ifndef OPENGL_TUTORIALS_GL_VIEWER_VIEWER_H_
 #define OPENGL_TUTORIALS_GL_VIEWER_VIEWER_H_
 
+#include "gl/core/sampler.h"
+#include "gl/core/texture_unit_allocator.h"
+#include "gl/scene/drawables/all.h"
+#include "gl/scene/label_declutterer.h"
 #include "gl/scene/scene_graph.h"
+#include "gl/scene/texture_pool.h"
 #include "gl/ui/glfw/viewer.h"
 #include "gl/utils/camera.h"
 
+#include <future>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,12 +36,16 @@ class SceneViewer {
     keys_to_remove_.emplace_back(key);
   }
 
-  /// Attach a new drawable to a node in the scene graph.
+  /// Attach a new drawable to a node in the scene graph. The texture of the
+  /// drawable gets its texture unit from the viewer.
   inline gl::SceneGraph::Key Attach(
       gl::SceneGraph::Key parent_key,
       gl::Drawable::SharedPtr drawable,
       const Eigen::Isometry3f& tf_parent_from_local =
           Eigen::Isometry3f::Identity()) {
+    if (drawable) {
+      drawable->SetTextureUnitAllocator(&texture_unit_allocator_);
+    }
     return graph_.Attach(parent_key, drawable, tf_parent_from_local);
   }
 
@@ -49,6 +60,14 @@ class SceneViewer {
     return Attach(viewport_key(), drawable, position_isometry);
   }
 
+  /// Hide the labels of the batch that would overlap labels with a higher
+  /// priority on the screen, one priority per label. The labels are
+  /// decluttered on a worker thread while a frame is drawn and the result is
+  /// shown in the next frame. The anchors of the labels must be in the world
+  /// frame. Call this again after changing the labels of the batch.
+  void DeclutterLabels(const std::shared_ptr<TextBatch>& labels,
+                       const std::vector<float>& priorities);
+
   gl::Camera& camera() { return camera_; }
 
   void OnMouseEvent(gl::core::MouseKey key,
@@ -68,6 +87,11 @@ class SceneViewer {
   const ProgramPool& program_pool() const noexcept { return program_pool_; }
   ProgramPool& program_pool() noexcept { return program_pool_; }
 
+  const TexturePool& texture_pool() const noexcept { return texture_pool_; }
+  TexturePool& texture_pool() noexcept { return texture_pool_; }
+
+  SamplerCache& sampler_cache() noexcept { return sampler_cache_; }
+
  protected:
   void Paint();
 
@@ -78,12 +102,31 @@ class SceneViewer {
   /// Called from gui thread, this actually erases drawables from the graph.
   void EraseScheduledKeys();
 
+  /// Show the labels that were found visible during the previous frame and
+  /// start decluttering them for the current camera.
+  void UpdateLabelVisibility();
+
+  struct DeclutteredLabels {
+    std::shared_ptr<TextBatch> labels{};
+    std::unique_ptr<LabelDeclutterer> declutterer{};
+    std::future<std::vector<bool>> visibility{};
+  };
+
   /// The underlying viewer.
   glfw::Viewer viewer_;
 
   /// Program pool to use to create all drawables.
   ProgramPool program_pool_;
 
+  /// Texture pool to share textures between drawables.
+  TexturePool texture_pool_;
+
+  /// Samplers shared between drawables with the same sampling parameters.
+  SamplerCache sampler_cache_;
+
+  /// Picks texture units for the textures of all drawables.
+  TextureUnitAllocator texture_unit_allocator_;
+
   /// A convenience bool to not cause multiple redraws for queued updates.
   bool update_pending_;
   /// As we cannot init opengl in constructor, we have to check if it is
@@ -103,6 +146,8 @@ class SceneViewer {
   gl::SceneGraph::Key camera_key_;
 
   std::vector<gl::SceneGraph::Key> keys_to_remove_;
+
+  std::vector<DeclutteredLabels> decluttered_labels_;
 };
 
 }  // namespace gl
@@ -0,0 +1,124 @@
+#ifndef OPENGL_TUTORIALS_UTILS_COMPRESSED_IMAGE_H_
+#define OPENGL_TUTORIALS_UTILS_COMPRESSED_IMAGE_H_
+
+#include "utils/file_utils.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <vector>
+
+namespace utils {
+
+/// An image that is already encoded in a GPU-compressed format, e.g., BC1,
+/// BC4 or BC7, with all of its mip levels.
+///
+/// Such images are meant to be uploaded to the GPU as they are, so they are
+/// never decoded on the CPU.
+class CompressedImage {
+ public:
+  struct Level {
+    std::int32_t width{};
+    std::int32_t height{};
+    std::size_t offset{};
+    std::size_t size{};
+  };
+
+  /// Read a KTX (version 1) file. Only little-endian, compressed,
+  /// two-dimensional textures without array layers and cube map faces are
+  /// supported.
+  static std::optional<CompressedImage> CreateFromKtx(
+      const std::filesystem::path& path) {
+    if (!utils::FileExists(path)) { return {}; }
+    std::ifstream file{path, std::ios::binary};
+    if (!file) { return {}; }
+    const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>{file},
+                                          std::istreambuf_iterator<char>{}};
+    return CreateFromKtxBytes(bytes);
+  }
+
+  static std::optional<CompressedImage> CreateFromKtxBytes(
+      const std::vector<std::uint8_t>& bytes) {
+    constexpr std::uint8_t kIdentifier[]{0xAB, 'K',  'T',  'X',  ' ', '1',
+                                         '1',  0xBB, '\r', '\n', 0x1A, '\n'};
+    constexpr std::uint32_t kEndianness{0x04030201};
+    constexpr std::size_t kHeaderSize{64ul};
+    // The sizes of the levels halve a 32 bit size, so there are at most 32.
+    constexpr std::uint32_t kMaxNumberOfLevels{32u};
+    if (bytes.size() < kHeaderSize || !std::equal(std::begin(kIdentifier),
+                                                  std::end(kIdentifier),
+                                                  bytes.begin())) {
+      return {};
+    }
+    std::size_t offset{sizeof(kIdentifier)};
+    const auto read_uint32 = [&bytes, &offset]() {
+      std::uint32_t value{};
+      std::memcpy(&value, bytes.data() + offset, sizeof(value));
+      offset += sizeof(value);
+      return value;
+    };
+    const auto endianness{read_uint32()};
+    const auto gl_type{read_uint32()};
+    read_uint32();  // glTypeSize
+    read_uint32();  // glFormat
+    const auto gl_internal_format{read_uint32()};
+    read_uint32();  // glBaseInternalFormat
+    const auto width{read_uint32()};
+    const auto height{read_uint32()};
+    const auto depth{read_uint32()};
+    const auto number_of_array_elements{read_uint32()};
+    const auto number_of_faces{read_uint32()};
+    const auto number_of_levels{std::max(1u, read_uint32())};
+    const auto bytes_of_key_value_data{read_uint32()};
+    if (endianness != kEndianness || gl_type != 0u || width == 0u ||
+        height == 0u || depth > 1u || number_of_array_elements > 0u ||
+        number_of_faces != 1u || number_of_levels > kMaxNumberOfLevels) {
+      return {};
+    }
+    offset += bytes_of_key_value_data;
+
+    CompressedImage image{};
+    image.internal_format_ = gl_internal_format;
+    image.data_ = bytes;
+    for (std::uint32_t level = 0; level < number_of_levels; ++level) {
+      if (offset + sizeof(std::uint32_t) > bytes.size()) { return {}; }
+      const auto image_size{read_uint32()};
+      if (offset + image_size > bytes.size()) { return {}; }
+      image.levels_.push_back(
+          {static_cast<std::int32_t>(std::max(1u, width >> level)),
+           static_cast<std::int32_t>(std::max(1u, height >> level)),
+           offset,
+           image_size});
+      // Every level is padded to 4 bytes.
+      offset += (image_size + 3u) & ~3u;
+    }
+    return image;
+  }
+
+  std::int32_t width() const { return levels_.front().width; }
+  std::int32_t height() const { return levels_.front().height; }
+
+  /// OpenGL enum of the compressed internal format.
+  std::uint32_t internal_format() const { return internal_format_; }
+
+  const std::vector<Level>& levels() const { return levels_; }
+
+  const std::uint8_t* level_data(std::size_t level) const {
+    return data_.data() + levels_[level].offset;
+  }
+
+ private:
+  CompressedImage() = default;
+
+  std::uint32_t internal_format_{};
+  std::vector<Level> levels_{};
+  std::vector<std::uint8_t> data_{};
+};
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_COMPRESSED_IMAGE_H_
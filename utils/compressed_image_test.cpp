@@ -0,0 +1,56 @@
+#include "utils/compressed_image.h"
+#include "utils/ktx_test_utils.h"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+using utils::CompressedImage;
+
+namespace {
+constexpr std::uint32_t kCompressedRedRgtc1{0x8DBB};
+
+/// Create a KTX file contents with one 4x4 block per level.
+std::vector<std::uint8_t> CreateKtx(std::uint32_t width,
+                                    std::uint32_t height,
+                                    std::uint32_t number_of_levels) {
+  std::vector<std::vector<std::uint8_t>> levels{};
+  for (std::uint32_t level = 0; level < number_of_levels; ++level) {
+    levels.emplace_back(8u, static_cast<std::uint8_t>(level));
+  }
+  return utils::CreateKtxBytes(
+      kCompressedRedRgtc1, 0x1903u /* GL_RED */, width, height, levels);
+}
+}  // namespace
+
+TEST(CompressedImageTest, ReadKtx) {
+  const auto image{CompressedImage::CreateFromKtxBytes(CreateKtx(4, 2, 3))};
+  ASSERT_TRUE(image.has_value());
+  EXPECT_EQ(4, image->width());
+  EXPECT_EQ(2, image->height());
+  EXPECT_EQ(kCompressedRedRgtc1, image->internal_format());
+  ASSERT_EQ(3ul, image->levels().size());
+  EXPECT_EQ(2, image->levels()[1].width);
+  EXPECT_EQ(1, image->levels()[1].height);
+  EXPECT_EQ(1, image->levels()[2].width);
+  EXPECT_EQ(1, image->levels()[2].height);
+  for (std::size_t level = 0; level < 3; ++level) {
+    EXPECT_EQ(8ul, image->levels()[level].size);
+    EXPECT_EQ(level, image->level_data(level)[0]);
+  }
+}
+
+TEST(CompressedImageTest, ReadBrokenKtx) {
+  auto bytes{CreateKtx(4, 4, 1)};
+  bytes.pop_back();
+  EXPECT_FALSE(CompressedImage::CreateFromKtxBytes(bytes).has_value());
+  bytes = CreateKtx(4, 4, 1);
+  bytes[1] = 'X';
+  EXPECT_FALSE(CompressedImage::CreateFromKtxBytes(bytes).has_value());
+  EXPECT_FALSE(CompressedImage::CreateFromKtx("non_existing_path").has_value());
+  // Sizes of more than 32 levels cannot be computed by halving a 32 bit size.
+  EXPECT_FALSE(
+      CompressedImage::CreateFromKtxBytes(CreateKtx(4, 4, 33)).has_value());
+  EXPECT_TRUE(
+      CompressedImage::CreateFromKtxBytes(CreateKtx(4, 4, 32)).has_value());
+}
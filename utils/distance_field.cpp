@@ -0,0 +1,134 @@
+#include "utils/distance_field.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+constexpr float kInfinity{std::numeric_limits<float>::infinity()};
+
+/// One-dimensional squared distance transform of sampled functions by
+/// Felzenszwalb and Huttenlocher. Computes the lower envelope of parabolas
+/// rooted at every sample in linear time.
+void TransformLine(const float* values,
+                   int size,
+                   float* result,
+                   std::vector<int>* parabola_positions,
+                   std::vector<float>* boundaries) {
+  auto& positions{*parabola_positions};
+  auto& bounds{*boundaries};
+  // Position where the parabolas rooted at two samples intersect.
+  const auto intersect = [values](int lhs, int rhs) {
+    return ((values[rhs] + rhs * rhs) - (values[lhs] + lhs * lhs)) /
+           (2.0f * (rhs - lhs));
+  };
+  int number_of_parabolas{};
+  for (int i = 0; i < size; ++i) {
+    if (values[i] == kInfinity) { continue; }
+    float bound{-kInfinity};
+    while (number_of_parabolas > 0) {
+      bound = intersect(positions[number_of_parabolas - 1], i);
+      if (bound > bounds[number_of_parabolas - 1]) { break; }
+      --number_of_parabolas;
+      bound = -kInfinity;
+    }
+    positions[number_of_parabolas] = i;
+    bounds[number_of_parabolas] = bound;
+    ++number_of_parabolas;
+  }
+  if (number_of_parabolas == 0) {
+    std::fill(result, result + size, kInfinity);
+    return;
+  }
+  int parabola{};
+  for (int i = 0; i < size; ++i) {
+    while (parabola + 1 < number_of_parabolas &&
+           bounds[parabola + 1] < static_cast<float>(i)) {
+      ++parabola;
+    }
+    const int position{positions[parabola]};
+    const float offset{static_cast<float>(i - position)};
+    result[i] = offset * offset + values[position];
+  }
+}
+
+}  // namespace
+
+namespace utils {
+
+std::vector<float> ComputeSquaredDistanceTransform(
+    const std::vector<bool>& is_feature, int width, int height) {
+  std::vector<float> distances(is_feature.size());
+  std::transform(is_feature.begin(),
+                 is_feature.end(),
+                 distances.begin(),
+                 [](bool feature) { return feature ? 0.0f : kInfinity; });
+  const int max_size{std::max(width, height)};
+  std::vector<int> positions(max_size);
+  std::vector<float> boundaries(max_size);
+  std::vector<float> line(max_size);
+  std::vector<float> transformed_line(max_size);
+  // Columns first, then rows.
+  for (int col = 0; col < width; ++col) {
+    for (int row = 0; row < height; ++row) {
+      line[row] = distances[row * width + col];
+    }
+    TransformLine(line.data(),
+                  height,
+                  transformed_line.data(),
+                  &positions,
+                  &boundaries);
+    for (int row = 0; row < height; ++row) {
+      distances[row * width + col] = transformed_line[row];
+    }
+  }
+  for (int row = 0; row < height; ++row) {
+    auto* const row_start{&distances[row * width]};
+    TransformLine(
+        row_start, width, transformed_line.data(), &positions, &boundaries);
+    std::copy(
+        transformed_line.begin(), transformed_line.begin() + width, row_start);
+  }
+  return distances;
+}
+
+std::optional<Image> ComputeSignedDistanceField(const Image& image,
+                                                int channel,
+                                                float spread_in_pixels,
+                                                std::uint8_t threshold) {
+  if (image.data() == nullptr ||
+      image.data_type() != Image::DataType::kUint8 || channel < 0 ||
+      channel >= image.number_of_channels() || spread_in_pixels <= 0.0f) {
+    return {};
+  }
+  const int width{image.width()};
+  const int height{image.height()};
+  const std::size_t number_of_pixels{static_cast<std::size_t>(width) *
+                                     static_cast<std::size_t>(height)};
+  std::vector<bool> is_inside(number_of_pixels);
+  for (std::size_t i = 0; i < number_of_pixels; ++i) {
+    is_inside[i] =
+        image.data()[i * image.number_of_channels() + channel] >= threshold;
+  }
+  const auto distances_to_inside{
+      ComputeSquaredDistanceTransform(is_inside, width, height)};
+  is_inside.flip();
+  const auto distances_to_outside{
+      ComputeSquaredDistanceTransform(is_inside, width, height)};
+
+  auto field{Image::CreateFromData(width, height, 1)};
+  for (std::size_t i = 0; i < number_of_pixels; ++i) {
+    // The edge lies half way between an inside and an outside pixel.
+    const float signed_distance{
+        distances_to_inside[i] == 0.0f
+            ? std::sqrt(distances_to_outside[i]) - 0.5f
+            : 0.5f - std::sqrt(distances_to_inside[i])};
+    const float value{0.5f + 0.5f * signed_distance / spread_in_pixels};
+    field.data()[i] = static_cast<std::uint8_t>(
+        std::lround(255.0f * std::clamp(value, 0.0f, 1.0f)));
+  }
+  return field;
+}
+
+}  // namespace utils
@@ -0,0 +1,34 @@
+#ifndef OPENGL_TUTORIALS_UTILS_DISTANCE_FIELD_H_
+#define OPENGL_TUTORIALS_UTILS_DISTANCE_FIELD_H_
+
+#include "utils/image.h"
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace utils {
+
+/// Squared Euclidean distance from every pixel of a width x height grid to the
+/// closest pixel marked as a feature. Pixels are stored row by row. Grids
+/// without features get infinite distances.
+std::vector<float> ComputeSquaredDistanceTransform(
+    const std::vector<bool>& is_feature, int width, int height);
+
+/// Compute a signed distance field of the shape formed by all the pixels that
+/// have at least the threshold value in a channel of an 8-bit image.
+///
+/// The result is a single channel 8-bit image of the same size. The edge of
+/// the shape maps to 128, larger values are inside of the shape. Distances
+/// are clamped to the spread and 0 or 255 mean that the edge is at least
+/// spread_in_pixels away. Returns an empty optional if the image is empty, not
+/// 8-bit or has no such channel.
+std::optional<Image> ComputeSignedDistanceField(
+    const Image& image,
+    int channel,
+    float spread_in_pixels = 8.0f,
+    std::uint8_t threshold = 128u);
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_DISTANCE_FIELD_H_
@@ -0,0 +1,62 @@
+#include "utils/distance_field.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+using utils::ComputeSignedDistanceField;
+using utils::ComputeSquaredDistanceTransform;
+using utils::Image;
+
+TEST(DistanceFieldTest, SquaredDistanceToClosestFeature) {
+  constexpr int kWidth{7};
+  constexpr int kHeight{5};
+  std::vector<bool> is_feature(kWidth * kHeight, false);
+  is_feature[1 * kWidth + 1] = true;
+  is_feature[3 * kWidth + 5] = true;
+  const auto distances{
+      ComputeSquaredDistanceTransform(is_feature, kWidth, kHeight)};
+  ASSERT_EQ(is_feature.size(), distances.size());
+  for (int row = 0; row < kHeight; ++row) {
+    for (int col = 0; col < kWidth; ++col) {
+      const float expected{std::min(
+          static_cast<float>((row - 1) * (row - 1) + (col - 1) * (col - 1)),
+          static_cast<float>((row - 3) * (row - 3) + (col - 5) * (col - 5)))};
+      EXPECT_FLOAT_EQ(expected, distances[row * kWidth + col])
+          << "row: " << row << ", col: " << col;
+    }
+  }
+  const auto empty{ComputeSquaredDistanceTransform(
+      std::vector<bool>(kWidth * kHeight, false), kWidth, kHeight)};
+  EXPECT_TRUE(std::isinf(empty.front()));
+}
+
+TEST(DistanceFieldTest, SignedDistanceOfSquare) {
+  // A 4x4 square in the alpha channel of a 16x16 RGBA image.
+  constexpr int kSize{16};
+  auto image{Image::CreateFromData(kSize, kSize, 4)};
+  for (int row = 6; row < 10; ++row) {
+    for (int col = 6; col < 10; ++col) {
+      image.data()[(row * kSize + col) * 4 + 3] = 255;
+    }
+  }
+  const auto field{ComputeSignedDistanceField(image, 3, 4.0f)};
+  ASSERT_TRUE(field.has_value());
+  EXPECT_EQ(kSize, field->width());
+  EXPECT_EQ(kSize, field->height());
+  EXPECT_EQ(1, field->number_of_channels());
+  const auto at = [&field](int row, int col) {
+    return field->data()[row * kSize + col];
+  };
+  // Pixels next to the edge are half a pixel away from it.
+  EXPECT_EQ(143, at(6, 6));
+  EXPECT_EQ(112, at(6, 5));
+  // Deeper inside the values grow, far outside they are clamped.
+  EXPECT_GT(at(7, 7), at(6, 7));
+  EXPECT_LT(at(6, 3), at(6, 5));
+  EXPECT_EQ(0, at(0, 0));
+  EXPECT_FALSE(ComputeSignedDistanceField(image, 4).has_value());
+  const auto pixel{Image::CreateFromData(1, 1, 1)};
+  EXPECT_FALSE(ComputeSignedDistanceField(pixel, 0, 0.0f).has_value());
+}
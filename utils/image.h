@@ -5,42 +5,315 @@
 #include "stb/stb_image.h"
 #include "utils/file_utils.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <optional>
+#include <utility>
 
 namespace utils {
 
 class Image {
  public:
-  static std::optional<Image> CreateFrom(const std::filesystem::path& path,
-                                         bool flip_vertically = false) {
+  /// Type of a single channel of a pixel.
+  enum class DataType { kUint8, kUint16, kFloat };
+
+  /// Load an image from disk. Images can be loaded with 16 bits or floats
+  /// per channel to keep the precision of, e.g., depth or elevation data.
+  /// Note that stb converts 8-bit files loaded as floats to linear space.
+  ///
+  /// This function can be called from many threads at once. It never uses the
+  /// global flip flag of stb and flips the decoded rows itself instead.
+  static std::optional<Image> CreateFrom(
+      const std::filesystem::path& path,
+      bool flip_vertically = false,
+      DataType data_type = DataType::kUint8) {
     if (!utils::FileExists(path)) { return {}; }
     Image image{};
-    image.LoadFromPath(path, flip_vertically);
+    image.LoadFromPath(path, flip_vertically, data_type);
+    return image;
+  }
+
+  /// Map a file with raw pixels into memory instead of reading and decoding
+  /// it. The pixels of the image point right into the mapped file, so they
+  /// are only read from the page cache when used, e.g., by a texture upload.
+  /// Writing to the pixels does not change the file.
+  ///
+  /// Supported are binary 8-bit PGM (P5) and PPM (P6) files and files written
+  /// by WriteRaw. Returns an empty optional for other or broken files.
+  static std::optional<Image> CreateFromMappedFile(
+      const std::filesystem::path& path) {
+    const auto file{MappedFile::Open(path)};
+    if (!file) { return {}; }
+    auto header{ParseRawHeader(file->data.get(), file->size)};
+    if (!header) { header = ParsePnmHeader(file->data.get(), file->size); }
+    if (!header) { return {}; }
+    Image image{};
+    image.width_ = header->width;
+    image.height_ = header->height;
+    image.number_of_channels_ = header->number_of_channels;
+    image.data_type_ = header->data_type;
+    if (header->offset + image.size_in_bytes() > file->size) { return {}; }
+    // Share the ownership of the whole mapping but point to the pixels.
+    image.data_ = ImagePtr{file->data, file->data.get() + header->offset};
+    return image;
+  }
+
+  /// Write the image into a file that can be mapped by CreateFromMappedFile.
+  /// The pixels follow a small header and are stored exactly as in memory.
+  bool WriteRaw(const std::filesystem::path& path) const {
+    if (!data_) { return false; }
+    std::ofstream file{path, std::ios::binary};
+    if (!file) { return false; }
+    file.write(kRawMagic, sizeof(kRawMagic));
+    for (const auto value : {width_,
+                             height_,
+                             number_of_channels_,
+                             static_cast<std::int32_t>(data_type_)}) {
+      file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    file.write(reinterpret_cast<const char*>(data_.get()), size_in_bytes());
+    return static_cast<bool>(file);
+  }
+
+  /// Write an 8-bit image with 1 or 3 channels into a binary PGM or PPM file
+  /// that can be mapped by CreateFromMappedFile.
+  bool WritePnm(const std::filesystem::path& path) const {
+    if (!data_ || data_type_ != DataType::kUint8 ||
+        (number_of_channels_ != 1 && number_of_channels_ != 3)) {
+      return false;
+    }
+    std::ofstream file{path, std::ios::binary};
+    if (!file) { return false; }
+    file << (number_of_channels_ == 1 ? "P5" : "P6") << '\n'
+         << width_ << ' ' << height_ << "\n255\n";
+    file.write(reinterpret_cast<const char*>(data_.get()), size_in_bytes());
+    return static_cast<bool>(file);
+  }
+
+  /// Create an image on top of existing pixel storage, e.g., a buffer taken
+  /// from a pool. The storage must hold at least size_in_bytes() bytes.
+  static Image CreateFromStorage(std::int32_t width,
+                                 std::int32_t height,
+                                 std::int32_t number_of_channels,
+                                 std::shared_ptr<std::uint8_t[]> storage,
+                                 DataType data_type = DataType::kUint8) {
+    Image image{};
+    image.width_ = width;
+    image.height_ = height;
+    image.number_of_channels_ = number_of_channels;
+    image.data_type_ = data_type;
+    image.data_ = std::move(storage);
+    return image;
+  }
+
+  /// Create an image that owns a copy of tightly packed pixel data.
+  static Image CreateFromData(std::int32_t width,
+                              std::int32_t height,
+                              std::int32_t number_of_channels,
+                              const void* const data = nullptr,
+                              DataType data_type = DataType::kUint8) {
+    Image image{};
+    image.width_ = width;
+    image.height_ = height;
+    image.number_of_channels_ = number_of_channels;
+    image.data_type_ = data_type;
+    const auto size{image.size_in_bytes()};
+    image.data_ = ImagePtr{new std::uint8_t[size]{}};
+    if (data) { std::memcpy(image.data_.get(), data, size); }
     return image;
   }
 
   std::int32_t width() const { return width_; }
   std::int32_t height() const { return height_; }
   std::int32_t number_of_channels() const { return number_of_channels_; }
+  DataType data_type() const { return data_type_; }
+  /// Raw bytes of the image. Use data_as to get typed pixels.
   std::uint8_t* data() const { return data_.get(); }
 
+  template <typename T>
+  const T* data_as() const {
+    return reinterpret_cast<const T*>(data_.get());
+  }
+
+  std::size_t bytes_per_channel() const {
+    return GetBytesPerChannel(data_type_);
+  }
+
+  static std::size_t GetBytesPerChannel(DataType data_type) {
+    switch (data_type) {
+      case DataType::kUint8: return sizeof(std::uint8_t);
+      case DataType::kUint16: return sizeof(std::uint16_t);
+      case DataType::kFloat: return sizeof(float);
+    }
+    return 0ul;
+  }
+
+  std::size_t size_in_bytes() const {
+    return static_cast<std::size_t>(width_) * height_ * number_of_channels_ *
+           bytes_per_channel();
+  }
+
+  /// Swap the rows of the image in place, so that the top row is at the
+  /// bottom.
+  void FlipVertically() {
+    if (!data_ || height_ < 2) { return; }
+    const std::size_t row_size{size_in_bytes() / height_};
+    auto* top{data_.get()};
+    auto* bottom{data_.get() + (height_ - 1) * row_size};
+    for (; top < bottom; top += row_size, bottom -= row_size) {
+      std::swap_ranges(top, top + row_size, bottom);
+    }
+  }
+
  private:
   using ImagePtr = std::shared_ptr<std::uint8_t[]>;
 
-  void LoadFromPath(const std::filesystem::path& path, bool flip_vertically) {
-    stbi_set_flip_vertically_on_load(flip_vertically);
-    data_ = ImagePtr{
-        stbi_load(path.c_str(), &width_, &height_, &number_of_channels_, 0),
-        stbi_image_free};
+  static constexpr char kRawMagic[8]{'I', 'G', 'L', 'O', 'O', 'R', 'A', 'W'};
+
+  struct Header {
+    std::int32_t width{};
+    std::int32_t height{};
+    std::int32_t number_of_channels{};
+    DataType data_type{};
+    /// Offset of the first pixel from the start of the file.
+    std::size_t offset{};
+  };
+
+  /// A read-only file mapped with copy-on-write pages.
+  struct MappedFile {
+    ImagePtr data{};
+    std::size_t size{};
+
+    static std::optional<MappedFile> Open(const std::filesystem::path& path) {
+      const int descriptor{open(path.c_str(), O_RDONLY)};
+      if (descriptor < 0) { return {}; }
+      struct stat file_stat {};
+      if (fstat(descriptor, &file_stat) != 0 || file_stat.st_size <= 0) {
+        close(descriptor);
+        return {};
+      }
+      const auto size{static_cast<std::size_t>(file_stat.st_size)};
+      void* const address{mmap(nullptr,
+                               size,
+                               PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE,
+                               descriptor,
+                               0)};
+      // The mapping stays valid after the descriptor is closed.
+      close(descriptor);
+      if (address == MAP_FAILED) { return {}; }
+      return MappedFile{
+          ImagePtr{static_cast<std::uint8_t*>(address),
+                   [size](std::uint8_t* data) { munmap(data, size); }},
+          size};
+    }
+  };
+
+  static std::optional<Header> ParseRawHeader(const std::uint8_t* bytes,
+                                              std::size_t size) {
+    constexpr std::size_t kHeaderSize{sizeof(kRawMagic) +
+                                      4ul * sizeof(std::int32_t)};
+    if (size < kHeaderSize ||
+        std::memcmp(bytes, kRawMagic, sizeof(kRawMagic)) != 0) {
+      return {};
+    }
+    std::int32_t values[4]{};
+    std::memcpy(values, bytes + sizeof(kRawMagic), sizeof(values));
+    const auto [width, height, channels, data_type] = values;
+    if (width <= 0 || height <= 0 || channels < 1 || channels > 4 ||
+        data_type < static_cast<std::int32_t>(DataType::kUint8) ||
+        data_type > static_cast<std::int32_t>(DataType::kFloat)) {
+      return {};
+    }
+    return Header{
+        width, height, channels, static_cast<DataType>(data_type), kHeaderSize};
   }
 
+  /// Parse the header of a binary PGM or PPM file. Only 8-bit files can be
+  /// used as they are, 16-bit ones store big-endian values.
+  static std::optional<Header> ParsePnmHeader(const std::uint8_t* bytes,
+                                              std::size_t size) {
+    if (size < 2ul || bytes[0] != 'P' || (bytes[1] != '5' && bytes[1] != '6')) {
+      return {};
+    }
+    std::size_t offset{2ul};
+    const auto read_number = [bytes, size, &offset]() -> std::optional<int> {
+      // Skip whitespace and comments that run until the end of the line.
+      while (offset < size) {
+        if (bytes[offset] == '#') {
+          while (offset < size && bytes[offset] != '\n') { ++offset; }
+        } else if (std::isspace(bytes[offset])) {
+          ++offset;
+        } else {
+          break;
+        }
+      }
+      if (offset >= size || !std::isdigit(bytes[offset])) { return {}; }
+      int number{};
+      while (offset < size && std::isdigit(bytes[offset])) {
+        number = number * 10 + (bytes[offset] - '0');
+        if (number > 1000000) { return {}; }
+        ++offset;
+      }
+      return number;
+    };
+    const auto width{read_number()};
+    const auto height{read_number()};
+    const auto max_value{read_number()};
+    // A single whitespace character separates the header from the pixels.
+    if (!width || !height || !max_value || offset >= size ||
+        !std::isspace(bytes[offset])) {
+      return {};
+    }
+    if (width.value() <= 0 || height.value() <= 0 || max_value.value() <= 0 ||
+        max_value.value() > 255) {
+      return {};
+    }
+    return Header{width.value(),
+                  height.value(),
+                  bytes[1] == '5' ? 1 : 3,
+                  DataType::kUint8,
+                  offset + 1ul};
+  }
+
+  void LoadFromPath(const std::filesystem::path& path,
+                    bool flip_vertically,
+                    DataType data_type) {
+    data_type_ = data_type;
+    void* data{};
+    switch (data_type) {
+      case DataType::kUint8:
+        data = stbi_load(
+            path.c_str(), &width_, &height_, &number_of_channels_, 0);
+        break;
+      case DataType::kUint16:
+        data = stbi_load_16(
+            path.c_str(), &width_, &height_, &number_of_channels_, 0);
+        break;
+      case DataType::kFloat:
+        data = stbi_loadf(
+            path.c_str(), &width_, &height_, &number_of_channels_, 0);
+        break;
+    }
+    data_ = ImagePtr{static_cast<std::uint8_t*>(data), stbi_image_free};
+    if (flip_vertically) { FlipVertically(); }
+  }
+
+
   std::int32_t width_{};
   std::int32_t height_{};
   std::int32_t number_of_channels_{};
+  DataType data_type_{DataType::kUint8};
   ImagePtr data_;
 };
 
@@ -0,0 +1,176 @@
+#ifndef OPENGL_TUTORIALS_UTILS_IMAGE_BUFFER_POOL_H_
+#define OPENGL_TUTORIALS_UTILS_IMAGE_BUFFER_POOL_H_
+
+#include "stb/stb_image.h"
+#include "utils/image.h"
+
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace utils {
+
+/// Recycles the pixel storage of images of the same size and format.
+///
+/// Streams of camera frames produce many images of the same size. Instead of
+/// allocating and freeing the pixels of every frame, images acquired from the
+/// pool give their storage back to it once the last copy of the image is
+/// gone. The pool keeps at most `capacity` unused buffers. Images may outlive
+/// the pool, their storage is then simply freed.
+///
+/// The pool can be used from many threads at once.
+class ImageBufferPool {
+ public:
+  struct Statistics {
+    /// Acquired images that reused a buffer.
+    std::size_t hits{};
+    /// Acquired images that needed a new buffer.
+    std::size_t misses{};
+    /// Buffers that were given back and kept for reuse.
+    std::size_t recycled{};
+    /// Buffers that were given back, but freed as the pool was full.
+    std::size_t dropped{};
+    /// Buffers that are currently unused.
+    std::size_t free_buffers{};
+    std::size_t free_bytes{};
+  };
+
+  static constexpr std::size_t kDefaultCapacity{8ul};
+
+  explicit ImageBufferPool(std::size_t capacity = kDefaultCapacity)
+      : state_{std::make_shared<State>()} {
+    state_->capacity = capacity;
+  }
+
+  ImageBufferPool(const ImageBufferPool&) = delete;
+  ImageBufferPool& operator=(const ImageBufferPool&) = delete;
+
+  /// Get an image with uninitialized pixels that uses pooled storage.
+  Image Acquire(std::int32_t width,
+                std::int32_t height,
+                std::int32_t number_of_channels,
+                Image::DataType data_type = Image::DataType::kUint8) {
+    const Key key{width, height, number_of_channels, data_type};
+    std::unique_ptr<std::uint8_t[]> buffer{};
+    {
+      std::lock_guard<std::mutex> lock{state_->mutex};
+      auto& free_buffers{state_->free_buffers[key]};
+      if (free_buffers.empty()) {
+        ++state_->statistics.misses;
+      } else {
+        ++state_->statistics.hits;
+        buffer = std::move(free_buffers.back());
+        free_buffers.pop_back();
+        --state_->statistics.free_buffers;
+        state_->statistics.free_bytes -= key.size_in_bytes();
+      }
+    }
+    if (!buffer) { buffer.reset(new std::uint8_t[key.size_in_bytes()]); }
+    const std::weak_ptr<State> weak_state{state_};
+    return Image::CreateFromStorage(
+        width,
+        height,
+        number_of_channels,
+        std::shared_ptr<std::uint8_t[]>{
+            buffer.release(),
+            [weak_state, key](std::uint8_t* data) {
+              std::unique_ptr<std::uint8_t[]> buffer{data};
+              if (const auto state{weak_state.lock()}) {
+                state->GiveBack(key, std::move(buffer));
+              }
+            }},
+        data_type);
+  }
+
+  /// Decode an encoded image, e.g., a JPEG frame, into pooled storage. The
+  /// pixels are decoded by stb and copied into the pooled buffer.
+  std::optional<Image> Decode(const std::uint8_t* encoded,
+                              std::size_t size,
+                              bool flip_vertically = false) {
+    if (size > static_cast<std::size_t>(INT_MAX)) { return {}; }
+    int width{};
+    int height{};
+    int number_of_channels{};
+    const std::unique_ptr<stbi_uc, void (*)(void*)> decoded{
+        stbi_load_from_memory(encoded,
+                              static_cast<int>(size),
+                              &width,
+                              &height,
+                              &number_of_channels,
+                              0),
+        stbi_image_free};
+    if (!decoded) { return {}; }
+    auto image{Acquire(width, height, number_of_channels)};
+    std::memcpy(image.data(), decoded.get(), image.size_in_bytes());
+    if (flip_vertically) { image.FlipVertically(); }
+    return image;
+  }
+
+  Statistics statistics() const {
+    std::lock_guard<std::mutex> lock{state_->mutex};
+    return state_->statistics;
+  }
+
+  std::size_t capacity() const noexcept { return state_->capacity; }
+
+  /// Free all unused buffers.
+  void Clear() {
+    std::lock_guard<std::mutex> lock{state_->mutex};
+    state_->free_buffers.clear();
+    state_->statistics.free_buffers = 0ul;
+    state_->statistics.free_bytes = 0ul;
+  }
+
+ private:
+  struct Key {
+    std::int32_t width{};
+    std::int32_t height{};
+    std::int32_t number_of_channels{};
+    Image::DataType data_type{};
+
+    std::size_t size_in_bytes() const {
+      return static_cast<std::size_t>(width) * height * number_of_channels *
+             Image::GetBytesPerChannel(data_type);
+    }
+
+    bool operator<(const Key& other) const {
+      return std::tie(width, height, number_of_channels, data_type) <
+             std::tie(other.width,
+                      other.height,
+                      other.number_of_channels,
+                      other.data_type);
+    }
+  };
+
+  /// Shared with the images, so that they can give their storage back.
+  struct State {
+    void GiveBack(const Key& key, std::unique_ptr<std::uint8_t[]> buffer) {
+      std::lock_guard<std::mutex> lock{mutex};
+      if (statistics.free_buffers >= capacity) {
+        ++statistics.dropped;
+        return;
+      }
+      ++statistics.recycled;
+      ++statistics.free_buffers;
+      statistics.free_bytes += key.size_in_bytes();
+      free_buffers[key].push_back(std::move(buffer));
+    }
+
+    mutable std::mutex mutex{};
+    std::map<Key, std::vector<std::unique_ptr<std::uint8_t[]>>> free_buffers{};
+    std::size_t capacity{};
+    Statistics statistics{};
+  };
+
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_IMAGE_BUFFER_POOL_H_
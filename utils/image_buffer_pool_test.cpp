@@ -0,0 +1,82 @@
+#include "utils/image_buffer_pool.h"
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using utils::Image;
+using utils::ImageBufferPool;
+
+TEST(ImageBufferPoolTest, RecycleBuffers) {
+  ImageBufferPool pool{2};
+  const std::uint8_t* first_data{};
+  {
+    const auto image{pool.Acquire(4, 2, 3)};
+    EXPECT_EQ(4, image.width());
+    EXPECT_EQ(2, image.height());
+    EXPECT_EQ(3, image.number_of_channels());
+    first_data = image.data();
+    // Copies share the storage, so it only goes back with the last copy.
+    const auto copy{image};
+  }
+  EXPECT_EQ(1ul, pool.statistics().free_buffers);
+  EXPECT_EQ(24ul, pool.statistics().free_bytes);
+  const auto same_size{pool.Acquire(4, 2, 3)};
+  EXPECT_EQ(first_data, same_size.data());
+  const auto other_size{pool.Acquire(2, 4, 3)};
+  EXPECT_NE(first_data, other_size.data());
+  const auto stats{pool.statistics()};
+  EXPECT_EQ(1ul, stats.hits);
+  EXPECT_EQ(2ul, stats.misses);
+  EXPECT_EQ(1ul, stats.recycled);
+  EXPECT_EQ(0ul, stats.free_buffers);
+}
+
+TEST(ImageBufferPoolTest, BoundedCapacity) {
+  ImageBufferPool pool{1};
+  {
+    std::vector<Image> images;
+    for (int i = 0; i < 3; ++i) {
+      images.push_back(pool.Acquire(8, 8, 1, Image::DataType::kFloat));
+    }
+  }
+  const auto stats{pool.statistics()};
+  EXPECT_EQ(1ul, stats.recycled);
+  EXPECT_EQ(2ul, stats.dropped);
+  EXPECT_EQ(1ul, stats.free_buffers);
+  EXPECT_EQ(8ul * 8ul * sizeof(float), stats.free_bytes);
+  pool.Clear();
+  EXPECT_EQ(0ul, pool.statistics().free_buffers);
+}
+
+TEST(ImageBufferPoolTest, ImagesOutliveThePool) {
+  std::optional<Image> image{};
+  {
+    ImageBufferPool pool{};
+    image = pool.Acquire(2, 2, 4);
+  }
+  image->data()[0] = 42;
+  image.reset();
+}
+
+TEST(ImageBufferPoolTest, Decode) {
+  std::ifstream file{"utils/test_images/container.jpg", std::ios::binary};
+  const std::vector<std::uint8_t> encoded{std::istreambuf_iterator<char>{file},
+                                          std::istreambuf_iterator<char>{}};
+  ASSERT_FALSE(encoded.empty());
+  const auto expected{Image::CreateFrom("utils/test_images/container.jpg")};
+  ASSERT_TRUE(expected.has_value());
+  ImageBufferPool pool{};
+  for (int frame = 0; frame < 3; ++frame) {
+    const auto image{pool.Decode(encoded.data(), encoded.size())};
+    ASSERT_TRUE(image.has_value());
+    EXPECT_EQ(512, image->width());
+    EXPECT_TRUE(std::equal(expected->data(),
+                           expected->data() + expected->size_in_bytes(),
+                           image->data()));
+  }
+  EXPECT_EQ(2ul, pool.statistics().hits);
+  const std::uint8_t garbage[]{1, 2, 3};
+  EXPECT_FALSE(pool.Decode(garbage, sizeof(garbage)).has_value());
+}
@@ -0,0 +1,75 @@
+#ifndef OPENGL_TUTORIALS_UTILS_IMAGE_LOADER_H_
+#define OPENGL_TUTORIALS_UTILS_IMAGE_LOADER_H_
+
+#include "utils/image.h"
+#include "utils/pixel_kernels.h"
+#include "utils/thread_pool.h"
+
+#include <filesystem>
+#include <future>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+/// Decodes images on a pool of worker threads.
+///
+/// Decoding is the slow part of loading many images, e.g., thumbnails at
+/// startup, so spreading it over all cores makes loading a batch of images
+/// take a fraction of the time.
+class ImageLoader {
+ public:
+  explicit ImageLoader(
+      std::size_t number_of_threads = std::thread::hardware_concurrency())
+      : thread_pool_{number_of_threads} {}
+
+  /// Start decoding an image. The future holds the same result as
+  /// Image::CreateFrom would return for these arguments.
+  std::future<std::optional<Image>> Load(
+      const std::filesystem::path& path,
+      bool flip_vertically = false,
+      Image::DataType data_type = Image::DataType::kUint8) {
+    return thread_pool_.Enqueue([path, flip_vertically, data_type]() {
+      return Image::CreateFrom(path, flip_vertically, data_type);
+    });
+  }
+
+  /// Start decoding all of the images. The futures are in the order of the
+  /// paths.
+  std::vector<std::future<std::optional<Image>>> LoadBatch(
+      const std::vector<std::filesystem::path>& paths,
+      bool flip_vertically = false,
+      Image::DataType data_type = Image::DataType::kUint8) {
+    std::vector<std::future<std::optional<Image>>> images{};
+    images.reserve(paths.size());
+    for (const auto& path : paths) {
+      images.emplace_back(Load(path, flip_vertically, data_type));
+    }
+    return images;
+  }
+
+  /// Start decoding an 8-bit image and computing all of its mip levels. RGB
+  /// images are expanded to RGBA, so the driver does not have to convert
+  /// them on upload. The levels are ready for Texture::SetImagePyramid. The
+  /// vector is empty if the image cannot be loaded.
+  std::future<std::vector<Image>> LoadPyramid(const std::filesystem::path& path,
+                                              bool flip_vertically = false) {
+    return thread_pool_.Enqueue([path, flip_vertically]() {
+      const auto image{Image::CreateFrom(path, flip_vertically)};
+      if (!image || !image->data()) { return std::vector<Image>{}; }
+      return BuildMipmapPyramid(ExpandToRgba(image.value()));
+    });
+  }
+
+  std::size_t number_of_threads() const noexcept {
+    return thread_pool_.number_of_threads();
+  }
+
+ private:
+  ThreadPool thread_pool_;
+};
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_IMAGE_LOADER_H_
@@ -0,0 +1,55 @@
+#include "utils/image_loader.h"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+
+using utils::Image;
+using utils::ImageLoader;
+
+TEST(ImageLoaderTest, LoadBatch) {
+  ImageLoader loader{4};
+  const std::vector<std::filesystem::path> paths{
+      "utils/test_images/container.jpg",
+      "non_existing_path",
+      "utils/test_images/container.jpg"};
+  auto images{loader.LoadBatch(paths)};
+  ASSERT_EQ(3ul, images.size());
+  const auto first{images[0].get()};
+  const auto missing{images[1].get()};
+  const auto last{images[2].get()};
+  ASSERT_TRUE(first.has_value());
+  EXPECT_FALSE(missing.has_value());
+  ASSERT_TRUE(last.has_value());
+  EXPECT_EQ(512, first->width());
+  EXPECT_TRUE(std::equal(
+      first->data(), first->data() + first->size_in_bytes(), last->data()));
+}
+
+TEST(ImageLoaderTest, FlipEachImageSeparately) {
+  const auto image{Image::CreateFrom("utils/test_images/container.jpg")};
+  ASSERT_TRUE(image.has_value());
+  ImageLoader loader{2};
+  auto flipped_future{loader.Load("utils/test_images/container.jpg", true)};
+  auto upright_future{loader.Load("utils/test_images/container.jpg", false)};
+  const auto flipped{flipped_future.get()};
+  const auto upright{upright_future.get()};
+  ASSERT_TRUE(flipped.has_value());
+  ASSERT_TRUE(upright.has_value());
+  const std::size_t row_size{static_cast<std::size_t>(image->width()) *
+                             image->number_of_channels()};
+  const auto* const last_row{image->data() + (image->height() - 1) * row_size};
+  EXPECT_TRUE(std::equal(last_row, last_row + row_size, flipped->data()));
+  EXPECT_TRUE(
+      std::equal(image->data(), image->data() + row_size, upright->data()));
+}
+
+TEST(ImageLoaderTest, LoadPyramid) {
+  ImageLoader loader{1};
+  auto future{loader.LoadPyramid("utils/test_images/container.jpg")};
+  const auto levels{future.get()};
+  ASSERT_EQ(10ul, levels.size());
+  EXPECT_EQ(4, levels.front().number_of_channels());
+  EXPECT_EQ(512, levels.front().width());
+  EXPECT_EQ(1, levels.back().width());
+  EXPECT_TRUE(loader.LoadPyramid("non_existing_path").get().empty());
+}
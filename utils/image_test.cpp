@@ -1,8 +1,27 @@
 #include "utils/image.h"
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
 using utils::Image;
 
+namespace {
+
+/// A file path that is only used by the current test, so that tests running
+/// in parallel do not write to the same file.
+std::filesystem::path TestFilePath(const std::string& extension) {
+  const auto* const test_info{
+      ::testing::UnitTest::GetInstance()->current_test_info()};
+  return std::filesystem::path{::testing::TempDir()} /
+         (std::string{"image_test_"} + test_info->name() + extension);
+}
+
+}  // namespace
+
 TEST(ImageTest, InitEmpty) {
   Image image{};
   EXPECT_EQ(0, image.width());
@@ -24,3 +43,93 @@ TEST(ImageTest, ReadWrong) {
   const auto image = Image::CreateFrom("non_existing_path");
   ASSERT_EQ(false, image.has_value());
 }
+
+TEST(ImageTest, CreateFromData) {
+  const std::uint8_t data[]{1, 2, 3, 4, 5, 6};
+  const auto image = Image::CreateFromData(1, 2, 3, data);
+  EXPECT_EQ(1, image.width());
+  EXPECT_EQ(2, image.height());
+  EXPECT_EQ(3, image.number_of_channels());
+  ASSERT_NE(nullptr, image.data());
+  EXPECT_NE(data, image.data());
+  EXPECT_TRUE(std::equal(data, data + 6, image.data()));
+  const auto empty_image = Image::CreateFromData(2, 2, 1);
+  ASSERT_NE(nullptr, empty_image.data());
+  EXPECT_EQ(0, empty_image.data()[3]);
+}
+
+TEST(ImageTest, ReadHighPrecision) {
+  const auto image_16 = Image::CreateFrom(
+      "utils/test_images/container.jpg", false, Image::DataType::kUint16);
+  ASSERT_TRUE(image_16.has_value());
+  EXPECT_EQ(Image::DataType::kUint16, image_16->data_type());
+  EXPECT_EQ(2ul, image_16->bytes_per_channel());
+  EXPECT_EQ(512ul * 512ul * 3ul * 2ul, image_16->size_in_bytes());
+  const auto image_float = Image::CreateFrom(
+      "utils/test_images/container.jpg", false, Image::DataType::kFloat);
+  ASSERT_TRUE(image_float.has_value());
+  EXPECT_EQ(Image::DataType::kFloat, image_float->data_type());
+  ASSERT_NE(nullptr, image_float->data_as<float>());
+  EXPECT_GE(image_float->data_as<float>()[0], 0.0f);
+  EXPECT_LE(image_float->data_as<float>()[0], 1.0f);
+}
+
+TEST(ImageTest, MapRawFile) {
+  const std::vector<float> pixels{0.5f, -1.0f, 2.0f, 4.0f, 8.0f, 16.0f};
+  const auto image = Image::CreateFromData(
+      3, 1, 2, pixels.data(), Image::DataType::kFloat);
+  const auto path{TestFilePath(".raw")};
+  ASSERT_TRUE(image.WriteRaw(path));
+  const auto mapped = Image::CreateFromMappedFile(path);
+  std::filesystem::remove(path);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_EQ(3, mapped->width());
+  EXPECT_EQ(1, mapped->height());
+  EXPECT_EQ(2, mapped->number_of_channels());
+  EXPECT_EQ(Image::DataType::kFloat, mapped->data_type());
+  EXPECT_TRUE(
+      std::equal(pixels.begin(), pixels.end(), mapped->data_as<float>()));
+}
+
+TEST(ImageTest, MapPnmFile) {
+  const auto path{TestFilePath(".pgm")};
+  {
+    std::ofstream file{path, std::ios::binary};
+    file << "P5\n# A comment.\n2 2\n255\n";
+    file.write("\x01\x02\x03\xff", 4);
+  }
+  const auto mapped = Image::CreateFromMappedFile(path);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_EQ(2, mapped->width());
+  EXPECT_EQ(2, mapped->height());
+  EXPECT_EQ(1, mapped->number_of_channels());
+  const std::uint8_t expected[]{1, 2, 3, 255};
+  EXPECT_TRUE(std::equal(expected, expected + 4, mapped->data()));
+  // Pixels can be changed without changing the file.
+  mapped->data()[0] = 42;
+  EXPECT_EQ(1, Image::CreateFromMappedFile(path)->data()[0]);
+  {
+    // The file is too short for its header.
+    std::ofstream file{path, std::ios::binary};
+    file << "P6\n2 2\n255\n";
+    file.write("\x01\x02\x03", 3);
+  }
+  EXPECT_FALSE(Image::CreateFromMappedFile(path).has_value());
+  std::filesystem::remove(path);
+  EXPECT_FALSE(Image::CreateFromMappedFile(path).has_value());
+}
+
+TEST(ImageTest, WritePnm) {
+  const auto path{TestFilePath(".ppm")};
+  const std::uint8_t pixels[]{1, 2, 3, 4, 5, 6};
+  const auto image{Image::CreateFromData(2, 1, 3, pixels)};
+  ASSERT_TRUE(image.WritePnm(path));
+  const auto mapped = Image::CreateFromMappedFile(path);
+  ASSERT_TRUE(mapped.has_value());
+  EXPECT_EQ(2, mapped->width());
+  EXPECT_EQ(1, mapped->height());
+  EXPECT_EQ(3, mapped->number_of_channels());
+  EXPECT_TRUE(std::equal(pixels, pixels + 6, mapped->data()));
+  EXPECT_FALSE(Image::CreateFromData(1, 1, 4).WritePnm(path));
+  std::filesystem::remove(path);
+}
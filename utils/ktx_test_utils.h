@@ -0,0 +1,51 @@
+#ifndef OPENGL_TUTORIALS_UTILS_KTX_TEST_UTILS_H_
+#define OPENGL_TUTORIALS_UTILS_KTX_TEST_UTILS_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+/// Create the contents of a KTX file with a compressed 2D image. Every entry
+/// of levels holds the bytes of one mip level.
+inline std::vector<std::uint8_t> CreateKtxBytes(
+    std::uint32_t internal_format,
+    std::uint32_t base_internal_format,
+    std::uint32_t width,
+    std::uint32_t height,
+    const std::vector<std::vector<std::uint8_t>>& levels) {
+  std::vector<std::uint8_t> bytes{
+      0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+  const auto append = [&bytes](std::uint32_t value) {
+    const auto* const value_bytes{
+        reinterpret_cast<const std::uint8_t*>(&value)};
+    bytes.insert(bytes.end(), value_bytes, value_bytes + sizeof(value));
+  };
+  for (const std::uint32_t value :
+       {0x04030201u,
+        0u,  // glType
+        1u,  // glTypeSize
+        0u,  // glFormat
+        internal_format,
+        base_internal_format,
+        width,
+        height,
+        0u,  // pixelDepth
+        0u,  // numberOfArrayElements
+        1u,  // numberOfFaces
+        static_cast<std::uint32_t>(levels.size()),
+        0u}) {  // bytesOfKeyValueData
+    append(value);
+  }
+  for (const auto& level : levels) {
+    append(static_cast<std::uint32_t>(level.size()));
+    bytes.insert(bytes.end(), level.begin(), level.end());
+    // Every level is padded to 4 bytes.
+    bytes.resize((bytes.size() + 3u) & ~std::size_t{3u});
+  }
+  return bytes;
+}
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_KTX_TEST_UTILS_H_
@@ -0,0 +1,372 @@
+#include "utils/pixel_kernels.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define UTILS_PIXEL_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using utils::SimdLevel;
+
+/// Never use an instruction set the CPU does not have, even if asked to.
+SimdLevel ClampToSupported(SimdLevel simd_level) {
+  return std::min(simd_level, utils::DetectSimdLevel());
+}
+
+inline std::uint8_t Average(int a, int b, int c, int d) {
+  return static_cast<std::uint8_t>((a + b + c + d + 2) / 4);
+}
+
+#ifdef UTILS_PIXEL_KERNELS_X86
+
+// Each of the kernels below processes as many pixels as it can without
+// reading or writing past the end of the data and returns their number. The
+// rest is processed by the scalar code.
+
+__attribute__((target("ssse3"))) std::size_t ExpandRgbToRgbaSsse3(
+    const std::uint8_t* rgb,
+    std::size_t number_of_pixels,
+    std::uint8_t alpha,
+    std::uint8_t* rgba) {
+  const __m128i shuffle{_mm_setr_epi8(
+      0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1)};
+  const __m128i alpha_mask{_mm_set1_epi32(
+      static_cast<int>(static_cast<std::uint32_t>(alpha) << 24))};
+  std::size_t i{};
+  // Every load reads 16 bytes, but only uses 12 of them.
+  for (; i + 6 <= number_of_pixels; i += 4) {
+    const __m128i source{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 3 * i))};
+    const __m128i result{
+        _mm_or_si128(_mm_shuffle_epi8(source, shuffle), alpha_mask)};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + 4 * i), result);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t ExpandRgbToRgbaAvx2(
+    const std::uint8_t* rgb,
+    std::size_t number_of_pixels,
+    std::uint8_t alpha,
+    std::uint8_t* rgba) {
+  // The shuffle works within 128-bit lanes, so each lane gets 4 pixels.
+  const __m256i shuffle{_mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1,
+                                         6, 7, 8, -1, 9, 10, 11, -1,
+                                         0, 1, 2, -1, 3, 4, 5, -1,
+                                         6, 7, 8, -1, 9, 10, 11, -1)};
+  const __m256i alpha_mask{_mm256_set1_epi32(
+      static_cast<int>(static_cast<std::uint32_t>(alpha) << 24))};
+  std::size_t i{};
+  for (; i + 10 <= number_of_pixels; i += 8) {
+    const auto* const source{rgb + 3 * i};
+    const __m256i lanes{_mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(source))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 12)),
+        1)};
+    const __m256i result{
+        _mm256_or_si256(_mm256_shuffle_epi8(lanes, shuffle), alpha_mask)};
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + 4 * i), result);
+  }
+  return i + ExpandRgbToRgbaSsse3(
+                 rgb + 3 * i, number_of_pixels - i, alpha, rgba + 4 * i);
+}
+
+__attribute__((target("ssse3"))) std::size_t SwapRedAndBlueSsse3(
+    const std::uint8_t* source,
+    std::size_t number_of_pixels,
+    std::uint8_t* target) {
+  // Swaps 5 pixels and keeps the 16th byte as it is.
+  const __m128i shuffle{_mm_setr_epi8(
+      2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15)};
+  std::size_t i{};
+  for (; i + 6 <= number_of_pixels; i += 5) {
+    const __m128i pixels{
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 3 * i))};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 3 * i),
+                     _mm_shuffle_epi8(pixels, shuffle));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) std::size_t SwapRedAndBlueAvx2(
+    const std::uint8_t* source,
+    std::size_t number_of_pixels,
+    std::uint8_t* target) {
+  const __m256i shuffle{_mm256_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7,
+                                         6, 11, 10, 9, 14, 13, 12, 15,
+                                         2, 1, 0, 5, 4, 3, 8, 7,
+                                         6, 11, 10, 9, 14, 13, 12, 15)};
+  std::size_t i{};
+  for (; i + 11 <= number_of_pixels; i += 10) {
+    const auto* const pixels{source + 3 * i};
+    const __m256i lanes{_mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + 15)),
+        1)};
+    const __m256i result{_mm256_shuffle_epi8(lanes, shuffle)};
+    // The second store overwrites the unchanged 16th byte of the first one.
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 3 * i),
+                     _mm256_castsi256_si128(result));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 3 * i + 15),
+                     _mm256_extracti128_si256(result, 1));
+  }
+  return i + SwapRedAndBlueSsse3(
+                 source + 3 * i, number_of_pixels - i, target + 3 * i);
+}
+
+/// Downsample a pair of rows into one. Only 1 and 4 channels are supported.
+__attribute__((target("ssse3"))) int DownsampleRowSsse3(
+    const std::uint8_t* top,
+    const std::uint8_t* bottom,
+    int target_width,
+    int number_of_channels,
+    std::uint8_t* target) {
+  const __m128i two{_mm_set1_epi16(2)};
+  int x{};
+  if (number_of_channels == 1) {
+    const __m128i ones{_mm_set1_epi8(1)};
+    for (; x + 8 <= target_width; x += 8) {
+      const __m128i top_pixels{
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 2 * x))};
+      const __m128i bottom_pixels{
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 2 * x))};
+      // Sums of horizontally neighboring pixels as 16-bit values.
+      __m128i sum{_mm_add_epi16(_mm_maddubs_epi16(top_pixels, ones),
+                                _mm_maddubs_epi16(bottom_pixels, ones))};
+      sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(target + x),
+                       _mm_packus_epi16(sum, sum));
+    }
+  } else if (number_of_channels == 4) {
+    const __m128i zero{_mm_setzero_si128()};
+    for (; x + 2 <= target_width; x += 2) {
+      const __m128i top_pixels{
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(top + 8 * x))};
+      const __m128i bottom_pixels{
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(bottom + 8 * x))};
+      // Vertical sums of the first and the last two pixels.
+      const __m128i first{
+          _mm_add_epi16(_mm_unpacklo_epi8(top_pixels, zero),
+                        _mm_unpacklo_epi8(bottom_pixels, zero))};
+      const __m128i last{
+          _mm_add_epi16(_mm_unpackhi_epi8(top_pixels, zero),
+                        _mm_unpackhi_epi8(bottom_pixels, zero))};
+      __m128i sum{_mm_unpacklo_epi64(
+          _mm_add_epi16(first, _mm_srli_si128(first, 8)),
+          _mm_add_epi16(last, _mm_srli_si128(last, 8)))};
+      sum = _mm_srli_epi16(_mm_add_epi16(sum, two), 2);
+      _mm_storel_epi64(reinterpret_cast<__m128i*>(target + 4 * x),
+                       _mm_packus_epi16(sum, sum));
+    }
+  }
+  return x;
+}
+
+__attribute__((target("avx2"))) int DownsampleRowAvx2(
+    const std::uint8_t* top,
+    const std::uint8_t* bottom,
+    int target_width,
+    int number_of_channels,
+    std::uint8_t* target) {
+  const __m256i two{_mm256_set1_epi16(2)};
+  int x{};
+  if (number_of_channels == 1) {
+    const __m256i ones{_mm256_set1_epi8(1)};
+    for (; x + 16 <= target_width; x += 16) {
+      const __m256i top_pixels{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + 2 * x))};
+      const __m256i bottom_pixels{_mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(bottom + 2 * x))};
+      __m256i sum{_mm256_add_epi16(_mm256_maddubs_epi16(top_pixels, ones),
+                                   _mm256_maddubs_epi16(bottom_pixels, ones))};
+      sum = _mm256_srli_epi16(_mm256_add_epi16(sum, two), 2);
+      // Packing works within lanes, so gather the results of both lanes.
+      const __m256i packed{_mm256_permute4x64_epi64(
+          _mm256_packus_epi16(sum, sum), 0xD8)};
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(target + x),
+                       _mm256_castsi256_si128(packed));
+    }
+  } else if (number_of_channels == 4) {
+    const __m256i zero{_mm256_setzero_si256()};
+    for (; x + 4 <= target_width; x += 4) {
+      const __m256i top_pixels{
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(top + 8 * x))};
+      const __m256i bottom_pixels{_mm256_loadu_si256(
+          reinterpret_cast<const __m256i*>(bottom + 8 * x))};
+      const __m256i first{
+          _mm256_add_epi16(_mm256_unpacklo_epi8(top_pixels, zero),
+                           _mm256_unpacklo_epi8(bottom_pixels, zero))};
+      const __m256i last{
+          _mm256_add_epi16(_mm256_unpackhi_epi8(top_pixels, zero),
+                           _mm256_unpackhi_epi8(bottom_pixels, zero))};
+      __m256i sum{_mm256_unpacklo_epi64(
+          _mm256_add_epi16(first, _mm256_srli_si256(first, 8)),
+          _mm256_add_epi16(last, _mm256_srli_si256(last, 8)))};
+      sum = _mm256_srli_epi16(_mm256_add_epi16(sum, two), 2);
+      const __m256i packed{_mm256_permute4x64_epi64(
+          _mm256_packus_epi16(sum, sum), 0xD8)};
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(target + 4 * x),
+                       _mm256_castsi256_si128(packed));
+    }
+  }
+  return x;
+}
+
+#endif  // UTILS_PIXEL_KERNELS_X86
+
+}  // namespace
+
+namespace utils {
+
+SimdLevel DetectSimdLevel() {
+#ifdef UTILS_PIXEL_KERNELS_X86
+  static const SimdLevel kSimdLevel{[]() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) { return SimdLevel::kAvx2; }
+    if (__builtin_cpu_supports("ssse3")) { return SimdLevel::kSsse3; }
+    return SimdLevel::kScalar;
+  }()};
+  return kSimdLevel;
+#else
+  return SimdLevel::kScalar;
+#endif
+}
+
+void ExpandRgbToRgba(const std::uint8_t* rgb,
+                     std::size_t number_of_pixels,
+                     std::uint8_t alpha,
+                     std::uint8_t* rgba,
+                     SimdLevel simd_level) {
+  std::size_t i{};
+#ifdef UTILS_PIXEL_KERNELS_X86
+  switch (ClampToSupported(simd_level)) {
+    case SimdLevel::kAvx2:
+      i = ExpandRgbToRgbaAvx2(rgb, number_of_pixels, alpha, rgba);
+      break;
+    case SimdLevel::kSsse3:
+      i = ExpandRgbToRgbaSsse3(rgb, number_of_pixels, alpha, rgba);
+      break;
+    case SimdLevel::kScalar: break;
+  }
+#endif
+  for (; i < number_of_pixels; ++i) {
+    rgba[4 * i] = rgb[3 * i];
+    rgba[4 * i + 1] = rgb[3 * i + 1];
+    rgba[4 * i + 2] = rgb[3 * i + 2];
+    rgba[4 * i + 3] = alpha;
+  }
+}
+
+void SwapRedAndBlue(const std::uint8_t* source,
+                    std::size_t number_of_pixels,
+                    std::uint8_t* target,
+                    SimdLevel simd_level) {
+  std::size_t i{};
+#ifdef UTILS_PIXEL_KERNELS_X86
+  switch (ClampToSupported(simd_level)) {
+    case SimdLevel::kAvx2:
+      i = SwapRedAndBlueAvx2(source, number_of_pixels, target);
+      break;
+    case SimdLevel::kSsse3:
+      i = SwapRedAndBlueSsse3(source, number_of_pixels, target);
+      break;
+    case SimdLevel::kScalar: break;
+  }
+#endif
+  for (; i < number_of_pixels; ++i) {
+    const auto red{source[3 * i]};
+    target[3 * i] = source[3 * i + 2];
+    target[3 * i + 1] = source[3 * i + 1];
+    target[3 * i + 2] = red;
+  }
+}
+
+void DownsampleBox2x2(const std::uint8_t* source,
+                      int width,
+                      int height,
+                      int number_of_channels,
+                      std::uint8_t* target,
+                      SimdLevel simd_level) {
+  const int target_width{std::max(1, width / 2)};
+  const int target_height{std::max(1, height / 2)};
+  const std::size_t stride{static_cast<std::size_t>(width) *
+                           number_of_channels};
+  // Images of width 1 have no horizontal pairs of pixels.
+  const int paired_width{width / 2};
+  simd_level = ClampToSupported(simd_level);
+  for (int y = 0; y < target_height; ++y) {
+    const auto* const top{source + 2 * y * stride};
+    const auto* const bottom{source + std::min(2 * y + 1, height - 1) * stride};
+    auto* const target_row{target + y * target_width * number_of_channels};
+    int x{};
+#ifdef UTILS_PIXEL_KERNELS_X86
+    switch (simd_level) {
+      case SimdLevel::kAvx2:
+        x = DownsampleRowAvx2(
+            top, bottom, paired_width, number_of_channels, target_row);
+        [[fallthrough]];
+      case SimdLevel::kSsse3:
+        x += DownsampleRowSsse3(top + 2 * x * number_of_channels,
+                                bottom + 2 * x * number_of_channels,
+                                paired_width - x,
+                                number_of_channels,
+                                target_row + x * number_of_channels);
+        break;
+      case SimdLevel::kScalar: break;
+    }
+#endif
+    for (; x < target_width; ++x) {
+      const int left{2 * x * number_of_channels};
+      const int right{std::min(2 * x + 1, width - 1) * number_of_channels};
+      for (int c = 0; c < number_of_channels; ++c) {
+        target_row[x * number_of_channels + c] = Average(top[left + c],
+                                                         top[right + c],
+                                                         bottom[left + c],
+                                                         bottom[right + c]);
+      }
+    }
+  }
+}
+
+Image ExpandToRgba(const Image& image, SimdLevel simd_level) {
+  if (image.number_of_channels() != 3 ||
+      image.data_type() != Image::DataType::kUint8 || !image.data()) {
+    return image;
+  }
+  auto rgba{Image::CreateFromData(image.width(), image.height(), 4)};
+  ExpandRgbToRgba(image.data(),
+                  static_cast<std::size_t>(image.width()) * image.height(),
+                  255,
+                  rgba.data(),
+                  simd_level);
+  return rgba;
+}
+
+std::vector<Image> BuildMipmapPyramid(const Image& image,
+                                      SimdLevel simd_level) {
+  if (image.data_type() != Image::DataType::kUint8 || !image.data()) {
+    return {};
+  }
+  std::vector<Image> levels{image};
+  while (levels.back().width() > 1 || levels.back().height() > 1) {
+    const auto& previous{levels.back()};
+    auto next{Image::CreateFromData(std::max(1, previous.width() / 2),
+                                    std::max(1, previous.height() / 2),
+                                    previous.number_of_channels())};
+    DownsampleBox2x2(previous.data(),
+                     previous.width(),
+                     previous.height(),
+                     previous.number_of_channels(),
+                     next.data(),
+                     simd_level);
+    levels.push_back(next);
+  }
+  return levels;
+}
+
+}  // namespace utils
@@ -0,0 +1,55 @@
+#ifndef OPENGL_TUTORIALS_UTILS_PIXEL_KERNELS_H_
+#define OPENGL_TUTORIALS_UTILS_PIXEL_KERNELS_H_
+
+#include "utils/image.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace utils {
+
+/// Instruction sets the pixel kernels can use. Every level includes the ones
+/// before it.
+enum class SimdLevel { kScalar, kSsse3, kAvx2 };
+
+/// The best instruction set supported by this CPU.
+SimdLevel DetectSimdLevel();
+
+/// Add an alpha channel to tightly packed RGB pixels. Source and target must
+/// not overlap.
+void ExpandRgbToRgba(const std::uint8_t* rgb,
+                     std::size_t number_of_pixels,
+                     std::uint8_t alpha,
+                     std::uint8_t* rgba,
+                     SimdLevel simd_level = DetectSimdLevel());
+
+/// Swap the first and the last channel of tightly packed 3-channel pixels,
+/// i.e., convert BGR to RGB or back. Source and target may be the same.
+void SwapRedAndBlue(const std::uint8_t* source,
+                    std::size_t number_of_pixels,
+                    std::uint8_t* target,
+                    SimdLevel simd_level = DetectSimdLevel());
+
+/// Downsample an 8-bit image to half of its size, rounded down, by averaging
+/// 2x2 blocks of pixels. The target holds max(1, width / 2) times
+/// max(1, height / 2) pixels.
+void DownsampleBox2x2(const std::uint8_t* source,
+                      int width,
+                      int height,
+                      int number_of_channels,
+                      std::uint8_t* target,
+                      SimdLevel simd_level = DetectSimdLevel());
+
+/// Create an RGBA copy of an 8-bit RGB image. Other images are returned as
+/// they are.
+Image ExpandToRgba(const Image& image,
+                   SimdLevel simd_level = DetectSimdLevel());
+
+/// Create all mip levels of an 8-bit image down to the size of 1x1. The first
+/// level is the image itself.
+std::vector<Image> BuildMipmapPyramid(const Image& image,
+                                      SimdLevel simd_level = DetectSimdLevel());
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_PIXEL_KERNELS_H_
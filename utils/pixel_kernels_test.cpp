@@ -0,0 +1,120 @@
+#include "utils/pixel_kernels.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using utils::SimdLevel;
+
+namespace {
+std::vector<std::uint8_t> CreateRandomBytes(std::size_t size) {
+  std::mt19937 generator{42};
+  std::uniform_int_distribution<int> distribution{0, 255};
+  std::vector<std::uint8_t> bytes(size);
+  for (auto& byte : bytes) {
+    byte = static_cast<std::uint8_t>(distribution(generator));
+  }
+  return bytes;
+}
+
+/// All instruction sets that this CPU can run.
+std::vector<SimdLevel> GetSupportedSimdLevels() {
+  std::vector<SimdLevel> levels{};
+  for (const auto level :
+       {SimdLevel::kScalar, SimdLevel::kSsse3, SimdLevel::kAvx2}) {
+    if (level <= utils::DetectSimdLevel()) { levels.push_back(level); }
+  }
+  return levels;
+}
+}  // namespace
+
+TEST(PixelKernelsTest, ExpandRgbToRgba) {
+  const std::uint8_t rgb[]{1, 2, 3, 4, 5, 6};
+  std::vector<std::uint8_t> rgba(8);
+  utils::ExpandRgbToRgba(rgb, 2, 255, rgba.data(), SimdLevel::kScalar);
+  EXPECT_EQ(std::vector<std::uint8_t>({1, 2, 3, 255, 4, 5, 6, 255}), rgba);
+  for (const std::size_t number_of_pixels : {1ul, 7ul, 33ul, 1001ul}) {
+    const auto source{CreateRandomBytes(3 * number_of_pixels)};
+    std::vector<std::uint8_t> expected(4 * number_of_pixels);
+    utils::ExpandRgbToRgba(source.data(),
+                           number_of_pixels,
+                           42,
+                           expected.data(),
+                           SimdLevel::kScalar);
+    for (const auto level : GetSupportedSimdLevels()) {
+      std::vector<std::uint8_t> result(4 * number_of_pixels);
+      utils::ExpandRgbToRgba(
+          source.data(), number_of_pixels, 42, result.data(), level);
+      EXPECT_EQ(expected, result) << "level " << static_cast<int>(level);
+    }
+  }
+}
+
+TEST(PixelKernelsTest, SwapRedAndBlue) {
+  std::vector<std::uint8_t> pixels{1, 2, 3, 4, 5, 6};
+  utils::SwapRedAndBlue(pixels.data(), 2, pixels.data(), SimdLevel::kScalar);
+  EXPECT_EQ(std::vector<std::uint8_t>({3, 2, 1, 6, 5, 4}), pixels);
+  for (const std::size_t number_of_pixels : {1ul, 6ul, 11ul, 1001ul}) {
+    const auto source{CreateRandomBytes(3 * number_of_pixels)};
+    std::vector<std::uint8_t> expected(source.size());
+    utils::SwapRedAndBlue(
+        source.data(), number_of_pixels, expected.data(), SimdLevel::kScalar);
+    for (const auto level : GetSupportedSimdLevels()) {
+      std::vector<std::uint8_t> result(source.size());
+      utils::SwapRedAndBlue(
+          source.data(), number_of_pixels, result.data(), level);
+      EXPECT_EQ(expected, result) << "level " << static_cast<int>(level);
+      // Swapping in place gives the same result.
+      auto in_place{source};
+      utils::SwapRedAndBlue(
+          in_place.data(), number_of_pixels, in_place.data(), level);
+      EXPECT_EQ(expected, in_place) << "level " << static_cast<int>(level);
+    }
+  }
+}
+
+TEST(PixelKernelsTest, DownsampleBox2x2) {
+  const std::uint8_t gray[]{0, 2, 4, 6, 8, 10, 12, 14};
+  std::vector<std::uint8_t> half(2);
+  utils::DownsampleBox2x2(gray, 4, 2, 1, half.data(), SimdLevel::kScalar);
+  EXPECT_EQ(std::vector<std::uint8_t>({5, 9}), half);
+  for (const int channels : {1, 2, 3, 4}) {
+    for (const auto& [width, height] :
+         {std::pair{1, 1}, {1, 7}, {9, 1}, {37, 21}, {128, 64}}) {
+      const auto source{CreateRandomBytes(width * height * channels)};
+      const int target_size{std::max(1, width / 2) * std::max(1, height / 2) *
+                            channels};
+      std::vector<std::uint8_t> expected(target_size);
+      utils::DownsampleBox2x2(source.data(),
+                              width,
+                              height,
+                              channels,
+                              expected.data(),
+                              SimdLevel::kScalar);
+      for (const auto level : GetSupportedSimdLevels()) {
+        std::vector<std::uint8_t> result(target_size);
+        utils::DownsampleBox2x2(
+            source.data(), width, height, channels, result.data(), level);
+        EXPECT_EQ(expected, result)
+            << "level " << static_cast<int>(level) << ", size " << width
+            << "x" << height << "x" << channels;
+      }
+    }
+  }
+}
+
+TEST(PixelKernelsTest, BuildMipmapPyramid) {
+  const auto rgb{CreateRandomBytes(6 * 3 * 3)};
+  const auto image{utils::ExpandToRgba(
+      utils::Image::CreateFromData(6, 3, 3, rgb.data()))};
+  ASSERT_EQ(4, image.number_of_channels());
+  EXPECT_EQ(255, image.data()[3]);
+  const auto levels{utils::BuildMipmapPyramid(image)};
+  ASSERT_EQ(3ul, levels.size());
+  EXPECT_EQ(image.data(), levels[0].data());
+  EXPECT_EQ(3, levels[1].width());
+  EXPECT_EQ(1, levels[1].height());
+  EXPECT_EQ(1, levels[2].width());
+  EXPECT_EQ(1, levels[2].height());
+  EXPECT_EQ(255, levels[2].data()[3]);
+}
@@ -0,0 +1,118 @@
+#ifndef OPENGL_TUTORIALS_UTILS_SKYLINE_PACKER_H_
+#define OPENGL_TUTORIALS_UTILS_SKYLINE_PACKER_H_
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace utils {
+
+/// Packs rectangles into a fixed-size area.
+///
+/// The packer keeps the "skyline", i.e., the top outline of all the
+/// rectangles placed so far, as a list of horizontal segments. Every new
+/// rectangle is put on top of the skyline at the lowest possible position,
+/// preferring the left-most one. This is a good fit for packing many small
+/// images of similar heights, like icons or glyphs.
+class SkylinePacker {
+ public:
+  struct Position {
+    int x{};
+    int y{};
+  };
+
+  SkylinePacker(int width, int height)
+      : width_{width}, height_{height}, skyline_{{0, 0, width}} {}
+
+  /// Find a place for a rectangle and mark it as occupied. Returns an empty
+  /// optional if the rectangle does not fit anymore.
+  std::optional<Position> Insert(int width, int height) {
+    if (width <= 0 || height <= 0) { return {}; }
+    std::size_t best_index{skyline_.size()};
+    Position best_position{};
+    int best_top{std::numeric_limits<int>::max()};
+    for (std::size_t i = 0; i < skyline_.size(); ++i) {
+      const auto y{FitAt(i, width, height)};
+      if (!y) { continue; }
+      const int top{y.value() + height};
+      if (top < best_top) {
+        best_top = top;
+        best_index = i;
+        best_position = {skyline_[i].x, y.value()};
+      }
+    }
+    if (best_index == skyline_.size()) { return {}; }
+    AddSegment(best_index, best_position, width, height);
+    used_height_ = std::max(used_height_, best_top);
+    return best_position;
+  }
+
+  int width() const noexcept { return width_; }
+  int height() const noexcept { return height_; }
+
+  /// Height of the highest occupied point.
+  int used_height() const noexcept { return used_height_; }
+
+ private:
+  struct Segment {
+    int x{};
+    int y{};
+    int width{};
+  };
+
+  /// Returns the y coordinate at which a rectangle would lie if its left side
+  /// is aligned with the segment with this index.
+  std::optional<int> FitAt(std::size_t index, int width, int height) const {
+    const int x{skyline_[index].x};
+    if (x + width > width_) { return {}; }
+    int y{};
+    int width_left{width};
+    for (auto i = index; width_left > 0; ++i) {
+      y = std::max(y, skyline_[i].y);
+      if (y + height > height_) { return {}; }
+      width_left -= skyline_[i].width;
+    }
+    return y;
+  }
+
+  void AddSegment(std::size_t index,
+                  const Position& position,
+                  int width,
+                  int height) {
+    skyline_.insert(skyline_.begin() + index,
+                    Segment{position.x, position.y + height, width});
+    // Shrink or remove the segments that are now covered by the new one.
+    const int right{position.x + width};
+    for (auto i = index + 1; i < skyline_.size();) {
+      auto& segment{skyline_[i]};
+      if (segment.x >= right) { break; }
+      const int segment_right{segment.x + segment.width};
+      if (segment_right <= right) {
+        skyline_.erase(skyline_.begin() + i);
+        continue;
+      }
+      segment.width = segment_right - right;
+      segment.x = right;
+      break;
+    }
+    // Merge the neighboring segments of the same height.
+    for (std::size_t i = 0; i + 1 < skyline_.size();) {
+      if (skyline_[i].y == skyline_[i + 1].y) {
+        skyline_[i].width += skyline_[i + 1].width;
+        skyline_.erase(skyline_.begin() + i + 1);
+        continue;
+      }
+      ++i;
+    }
+  }
+
+  int width_{};
+  int height_{};
+  int used_height_{};
+  std::vector<Segment> skyline_{};
+};
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_SKYLINE_PACKER_H_
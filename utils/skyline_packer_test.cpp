@@ -0,0 +1,74 @@
+#include "utils/skyline_packer.h"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using utils::SkylinePacker;
+
+namespace {
+struct Rect {
+  int x, y, width, height;
+};
+
+bool Overlap(const Rect& a, const Rect& b) {
+  return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+         b.y < a.y + a.height;
+}
+}  // namespace
+
+TEST(SkylinePackerTest, Init) {
+  SkylinePacker packer{64, 32};
+  EXPECT_EQ(64, packer.width());
+  EXPECT_EQ(32, packer.height());
+  EXPECT_EQ(0, packer.used_height());
+}
+
+TEST(SkylinePackerTest, FillRow) {
+  SkylinePacker packer{8, 8};
+  for (int i = 0; i < 4; ++i) {
+    const auto position{packer.Insert(2, 3)};
+    ASSERT_TRUE(position.has_value());
+    EXPECT_EQ(2 * i, position->x);
+    EXPECT_EQ(0, position->y);
+  }
+  const auto position{packer.Insert(8, 5)};
+  ASSERT_TRUE(position.has_value());
+  EXPECT_EQ(0, position->x);
+  EXPECT_EQ(3, position->y);
+  EXPECT_EQ(8, packer.used_height());
+  EXPECT_FALSE(packer.Insert(1, 1).has_value());
+}
+
+TEST(SkylinePackerTest, PutsIntoLowestGap) {
+  SkylinePacker packer{10, 10};
+  ASSERT_TRUE(packer.Insert(4, 6).has_value());
+  ASSERT_TRUE(packer.Insert(6, 2).has_value());
+  const auto position{packer.Insert(5, 3)};
+  ASSERT_TRUE(position.has_value());
+  EXPECT_EQ(4, position->x);
+  EXPECT_EQ(2, position->y);
+}
+
+TEST(SkylinePackerTest, TooLarge) {
+  SkylinePacker packer{10, 10};
+  EXPECT_FALSE(packer.Insert(11, 1).has_value());
+  EXPECT_FALSE(packer.Insert(1, 11).has_value());
+  EXPECT_FALSE(packer.Insert(0, 1).has_value());
+}
+
+TEST(SkylinePackerTest, NoOverlaps) {
+  SkylinePacker packer{128, 128};
+  std::vector<Rect> rects;
+  for (int i = 0; i < 200; ++i) {
+    const int width{1 + (i * 7) % 13};
+    const int height{1 + (i * 5) % 11};
+    const auto position{packer.Insert(width, height)};
+    if (!position) { continue; }
+    const Rect rect{position->x, position->y, width, height};
+    EXPECT_LE(rect.x + rect.width, 128);
+    EXPECT_LE(rect.y + rect.height, 128);
+    for (const auto& other : rects) { EXPECT_FALSE(Overlap(rect, other)); }
+    rects.push_back(rect);
+  }
+  EXPECT_GT(rects.size(), 100ul);
+}
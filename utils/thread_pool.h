@@ -0,0 +1,86 @@
+#ifndef OPENGL_TUTORIALS_UTILS_THREAD_POOL_H_
+#define OPENGL_TUTORIALS_UTILS_THREAD_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+/// A fixed number of worker threads that run tasks in the order they were
+/// added. The destructor finishes all tasks that are still queued.
+class ThreadPool {
+ public:
+  explicit ThreadPool(
+      std::size_t number_of_threads = std::thread::hardware_concurrency()) {
+    number_of_threads = std::max<std::size_t>(1ul, number_of_threads);
+    workers_.reserve(number_of_threads);
+    for (std::size_t i = 0; i < number_of_threads; ++i) {
+      workers_.emplace_back([this]() { RunWorker(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      stopping_ = true;
+    }
+    condition_.notify_all();
+    for (auto& worker : workers_) { worker.join(); }
+  }
+
+  /// Run a function on one of the workers. The future holds its result.
+  template <typename Function>
+  std::future<std::invoke_result_t<Function>> Enqueue(Function&& function) {
+    using Result = std::invoke_result_t<Function>;
+    // The std::function in the queue must be copyable, the task is not.
+    auto task{std::make_shared<std::packaged_task<Result()>>(
+        std::forward<Function>(function))};
+    auto future{task->get_future()};
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      tasks_.emplace([task]() { (*task)(); });
+    }
+    condition_.notify_one();
+    return future;
+  }
+
+  std::size_t number_of_threads() const noexcept { return workers_.size(); }
+
+ private:
+  void RunWorker() {
+    while (true) {
+      std::function<void()> task{};
+      {
+        std::unique_lock<std::mutex> lock{mutex_};
+        condition_.wait(lock,
+                        [this]() { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) { return; }
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  std::vector<std::thread> workers_{};
+  std::queue<std::function<void()>> tasks_{};
+  std::mutex mutex_{};
+  std::condition_variable condition_{};
+  bool stopping_{};
+};
+
+}  // namespace utils
+
+#endif  // OPENGL_TUTORIALS_UTILS_THREAD_POOL_H_
@@ -0,0 +1,33 @@
+#include "utils/thread_pool.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+using utils::ThreadPool;
+
+TEST(ThreadPoolTest, RunTasks) {
+  ThreadPool pool{3};
+  EXPECT_EQ(3ul, pool.number_of_threads());
+  std::vector<std::future<int>> results;
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(pool.Enqueue([i]() { return i * i; }));
+  }
+  for (int i = 0; i < 100; ++i) { EXPECT_EQ(i * i, results[i].get()); }
+}
+
+TEST(ThreadPoolTest, FinishQueuedTasksOnDestruction) {
+  std::atomic<int> counter{};
+  {
+    ThreadPool pool{2};
+    for (int i = 0; i < 50; ++i) {
+      pool.Enqueue([&counter]() { ++counter; });
+    }
+  }
+  EXPECT_EQ(50, counter.load());
+}
+
+TEST(ThreadPoolTest, AtLeastOneThread) {
+  ThreadPool pool{0};
+  EXPECT_EQ(1ul, pool.number_of_threads());
+  EXPECT_EQ(42, pool.Enqueue([]() { return 42; }).get());
+}